@@ -1,8 +1,9 @@
 #include "Assessment.h"
+#include "NameTable.h"
 
 // Constructor implementation
-Assessment::Assessment(std::string name, double weight, double grade, bool isTheory, bool isComplete) {
-    this->name = name;
+Assessment::Assessment(std::string_view name, double weight, double grade, bool isTheory, bool isComplete) {
+    this->nameId = NameTable::getShared().intern(name);
     this->weight = weight;
     this->grade = grade;
     this->isTheory = isTheory;
@@ -10,14 +11,15 @@ Assessment::Assessment(std::string name, double weight, double grade, bool isThe
 }
 
 // Getters implementations
-std::string Assessment::getName() const { return name; }
+std::string_view Assessment::getName() const { return NameTable::getShared().getName(nameId); }
+uint32_t Assessment::getNameId() const { return nameId; }
 double Assessment::getWeight() const { return weight; }
 double Assessment::getGrade() const { return grade; }
 bool Assessment::getIsTheory() const { return isTheory; }
 bool Assessment::getIsComplete() const { return isComplete; }
 
 // Setters implementations
-void Assessment::setName(std::string newName) { name = newName; }
+void Assessment::setName(std::string_view newName) { nameId = NameTable::getShared().intern(newName); }
 void Assessment::setWeight(double newWeight) { weight = newWeight; }
 void Assessment::setGrade(double newGrade) { grade = newGrade; }
 void Assessment::setIsTheory(bool newIsTheory) { isTheory = newIsTheory; };
@@ -1,29 +1,33 @@
 #ifndef ASSESSMENT_H
 #define ASSESSMENT_H
 
-#include <string>
+#include <cstdint>
+#include <string_view>
 
+// The name is held as an id into NameTable::getShared(), which keeps an
+// Assessment at 24 bytes and makes copying one allocation-free.
 class Assessment {
 private:
-    std::string name;
     double weight;
     double grade;
+    uint32_t nameId;
     bool isTheory; //theory vs lab
     bool isComplete;
 
 public:
     // Constructor declaration
-    Assessment(std::string name, double weight, double grade = 0.0, bool isTheory = true, bool isComplete = false);
+    Assessment(std::string_view name, double weight, double grade = 0.0, bool isTheory = true, bool isComplete = false);
     
     // Getters
-    std::string getName() const;
+    std::string_view getName() const;
+    uint32_t getNameId() const;
     double getWeight() const;
     double getGrade() const;
     bool getIsTheory() const;
     bool getIsComplete() const;
 
     // Setters
-    void setName(std::string newName);
+    void setName(std::string_view newName);
     void setWeight(double newWeight);
     void setGrade(double newGrade);
     void setIsTheory(bool newIsTheory);
@@ -0,0 +1,108 @@
+#include "AssessmentStore.h"
+#include "NameTable.h"
+
+AssessmentStore::AssessmentStore(const std::vector<Assessment>& assessments) {
+    reserve(static_cast<int>(assessments.size()));
+    for (const Assessment& assessment : assessments) {
+        add(assessment);
+    }
+}
+
+int AssessmentStore::getCount() const {
+    return static_cast<int>(weights.size());
+}
+
+void AssessmentStore::reserve(int count) {
+    nameIds.reserve(count);
+    weights.reserve(count);
+    grades.reserve(count);
+    theoryMask.reserve((count + 63) / 64);
+    completeMask.reserve((count + 63) / 64);
+}
+
+void AssessmentStore::clear() {
+    nameIds.clear();
+    weights.clear();
+    grades.clear();
+    theoryMask.clear();
+    completeMask.clear();
+}
+
+void AssessmentStore::assignBit(std::vector<uint64_t>& mask, int index, bool value) {
+    uint64_t bit = uint64_t(1) << (index & 63);
+    if (value) {
+        mask[index >> 6] |= bit;
+    } else {
+        mask[index >> 6] &= ~bit;
+    }
+}
+
+// shift every bit above index down by one, keeping the unused tail bits zero
+void AssessmentStore::eraseBit(std::vector<uint64_t>& mask, int index, int count) {
+    int word = index >> 6;
+    uint64_t lowBits = (uint64_t(1) << (index & 63)) - 1;
+    uint64_t current = mask[word];
+    uint64_t shifted = (current & lowBits) | ((current >> 1) & ~lowBits);
+
+    for (size_t next = word + 1; next < mask.size(); next++) {
+        shifted |= (mask[next] & 1u) << 63;
+        mask[word] = shifted;
+        word = static_cast<int>(next);
+        shifted = mask[next] >> 1;
+    }
+    mask[word] = shifted;
+
+    if (((count - 1) + 63) / 64 < static_cast<int>(mask.size())) {
+        mask.pop_back();
+    }
+}
+
+void AssessmentStore::add(const Assessment& assessment) {
+    int index = getCount();
+    if ((index & 63) == 0) {
+        theoryMask.push_back(0);
+        completeMask.push_back(0);
+    }
+
+    nameIds.push_back(assessment.getNameId());
+    weights.push_back(assessment.getWeight());
+    grades.push_back(assessment.getGrade());
+    assignBit(theoryMask, index, assessment.getIsTheory());
+    assignBit(completeMask, index, assessment.getIsComplete());
+}
+
+void AssessmentStore::remove(int index) {
+    int count = getCount();
+    if (index < 0 || index >= count) {
+        return;
+    }
+
+    nameIds.erase(nameIds.begin() + index);
+    weights.erase(weights.begin() + index);
+    grades.erase(grades.begin() + index);
+    eraseBit(theoryMask, index, count);
+    eraseBit(completeMask, index, count);
+}
+
+Assessment AssessmentStore::getAssessment(int index) const {
+    return Assessment(getName(index), weights[index], grades[index], getIsTheory(index), getIsComplete(index));
+}
+
+std::vector<Assessment> AssessmentStore::toVector() const {
+    std::vector<Assessment> result;
+    result.reserve(weights.size());
+    for (int i = 0; i < getCount(); i++) {
+        result.push_back(getAssessment(i));
+    }
+    return result;
+}
+
+std::string_view AssessmentStore::getName(int index) const {
+    return NameTable::getShared().getName(nameIds[index]);
+}
+
+void AssessmentStore::setName(int index, std::string_view newName) { nameIds[index] = NameTable::getShared().intern(newName); }
+void AssessmentStore::setWeight(int index, double newWeight) { weights[index] = newWeight; }
+void AssessmentStore::setGrade(int index, double newGrade) { grades[index] = newGrade; }
+void AssessmentStore::setIsTheory(int index, bool newIsTheory) { assignBit(theoryMask, index, newIsTheory); }
+void AssessmentStore::setIsComplete(int index, bool newStatus) { assignBit(completeMask, index, newStatus); }
@@ -0,0 +1,116 @@
+#ifndef ASSESSMENT_STORE_H
+#define ASSESSMENT_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "Assessment.h"
+
+// Structure-of-arrays storage for a course's assessments. Weights and grades sit in
+// their own contiguous arrays and the theory/complete flags are packed 64 per word,
+// so aggregate passes never stride over the names, which are NameTable ids.
+class AssessmentStore {
+private:
+    std::vector<uint32_t> nameIds;
+    std::vector<double> weights;
+    std::vector<double> grades;
+    std::vector<uint64_t> theoryMask;
+    std::vector<uint64_t> completeMask;
+
+    static bool testBit(const std::vector<uint64_t>& mask, int index);
+    static void assignBit(std::vector<uint64_t>& mask, int index, bool value);
+    static void eraseBit(std::vector<uint64_t>& mask, int index, int count);
+
+public:
+    AssessmentStore() = default;
+    explicit AssessmentStore(const std::vector<Assessment>& assessments);
+
+    int getCount() const;
+    void reserve(int count);
+    void clear();
+
+    void add(const Assessment& assessment);
+    void remove(int index);
+
+    // materialise a row back into an Assessment
+    Assessment getAssessment(int index) const;
+    std::vector<Assessment> toVector() const;
+
+    //per-field access
+    std::string_view getName(int index) const;
+    uint32_t getNameId(int index) const { return nameIds[index]; }
+    double getWeight(int index) const { return weights[index]; }
+    double getGrade(int index) const { return grades[index]; }
+    bool getIsTheory(int index) const { return testBit(theoryMask, index); }
+    bool getIsComplete(int index) const { return testBit(completeMask, index); }
+
+    void setName(int index, std::string_view newName);
+    void setWeight(int index, double newWeight);
+    void setGrade(int index, double newGrade);
+    void setIsTheory(int index, bool newIsTheory);
+    void setIsComplete(int index, bool newStatus);
+
+    //raw columns for aggregate kernels
+    const double* getWeightData() const { return weights.data(); }
+    const double* getGradeData() const { return grades.data(); }
+    const uint64_t* getTheoryMaskData() const { return theoryMask.data(); }
+    const uint64_t* getCompleteMaskData() const { return completeMask.data(); }
+};
+
+// Non-owning, read-only handle on one row of an AssessmentStore. Mirrors the
+// Assessment getters so callers can switch between the two without rewriting.
+// Only valid while the store is alive and unchanged in size.
+class AssessmentView {
+private:
+    const AssessmentStore* store;
+    int index;
+
+public:
+    AssessmentView(const AssessmentStore* store, int index) : store(store), index(index) {}
+
+    std::string_view getName() const { return store->getName(index); }
+    uint32_t getNameId() const { return store->getNameId(index); }
+    double getWeight() const { return store->getWeight(index); }
+    double getGrade() const { return store->getGrade(index); }
+    bool getIsTheory() const { return store->getIsTheory(index); }
+    bool getIsComplete() const { return store->getIsComplete(index); }
+
+    Assessment toAssessment() const { return store->getAssessment(index); }
+};
+
+// Span-like range over a store, indexable and usable in range-for.
+class AssessmentRange {
+private:
+    const AssessmentStore* store;
+
+public:
+    class Iterator {
+    private:
+        const AssessmentStore* store;
+        int index;
+
+    public:
+        Iterator(const AssessmentStore* store, int index) : store(store), index(index) {}
+
+        AssessmentView operator*() const { return AssessmentView(store, index); }
+        Iterator& operator++() { index++; return *this; }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+    };
+
+    explicit AssessmentRange(const AssessmentStore* store) : store(store) {}
+
+    size_t size() const { return static_cast<size_t>(store->getCount()); }
+    bool empty() const { return store->getCount() == 0; }
+    AssessmentView operator[](size_t index) const { return AssessmentView(store, static_cast<int>(index)); }
+
+    Iterator begin() const { return Iterator(store, 0); }
+    Iterator end() const { return Iterator(store, store->getCount()); }
+};
+
+inline bool AssessmentStore::testBit(const std::vector<uint64_t>& mask, int index) {
+    return (mask[index >> 6] >> (index & 63)) & 1u;
+}
+
+#endif
@@ -0,0 +1,337 @@
+#include "CohortStatistics.h"
+#include "DurableFile.h"
+#include "NameTable.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+namespace {
+
+const char statisticsMagic[8] = {'G', 'R', 'D', 'S', 'T', 'A', 'T', '1'};
+const uint32_t statisticsVersion = 1;
+
+template<typename T>
+void appendValue(std::string& buffer, T value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void appendString(std::string& buffer, std::string_view value) {
+    appendValue<uint32_t>(buffer, static_cast<uint32_t>(value.size()));
+    buffer.append(value.data(), value.size());
+}
+
+template<typename T>
+bool readValue(std::string_view& bytes, T& value) {
+    if (bytes.size() < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, bytes.data(), sizeof(T));
+    bytes.remove_prefix(sizeof(T));
+    return true;
+}
+
+bool readString(std::string_view& bytes, std::string_view& value) {
+    uint32_t length;
+    if (!readValue(bytes, length) || length > bytes.size()) {
+        return false;
+    }
+    value = bytes.substr(0, length);
+    bytes.remove_prefix(length);
+    return true;
+}
+
+} // namespace
+
+void GradeStatistics::add(double grade) {
+    count++;
+    double delta = grade - mean;
+    mean += delta / count;
+    sumOfSquares += delta * (grade - mean);
+    if (count == 1) {
+        minimum = grade;
+        maximum = grade;
+    } else {
+        minimum = std::min(minimum, grade);
+        maximum = std::max(maximum, grade);
+    }
+
+    digest.add(grade);
+    int bin = static_cast<int>(grade / (100.0 / binCount));
+    histogram[std::min(std::max(bin, 0), binCount - 1)]++;
+}
+
+void GradeStatistics::merge(const GradeStatistics& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+
+    double total = static_cast<double>(count + other.count);
+    double delta = other.mean - mean;
+    mean += delta * other.count / total;
+    sumOfSquares += other.sumOfSquares + delta * delta * (static_cast<double>(count) * other.count / total);
+    count += other.count;
+    minimum = std::min(minimum, other.minimum);
+    maximum = std::max(maximum, other.maximum);
+
+    digest.merge(other.digest);
+    for (int i = 0; i < binCount; i++) {
+        histogram[i] += other.histogram[i];
+    }
+}
+
+void GradeStatistics::serialize(std::string& bytes) const {
+    appendValue<uint64_t>(bytes, count);
+    appendValue<double>(bytes, mean);
+    appendValue<double>(bytes, sumOfSquares);
+    appendValue<double>(bytes, minimum);
+    appendValue<double>(bytes, maximum);
+    for (uint64_t binCount : histogram) {
+        appendValue<uint64_t>(bytes, binCount);
+    }
+    digest.serialize(bytes);
+}
+
+bool GradeStatistics::deserialize(std::string_view& bytes) {
+    std::string_view input = bytes;
+    GradeStatistics stored;
+    if (!readValue(input, stored.count) || !readValue(input, stored.mean) || !readValue(input, stored.sumOfSquares) ||
+        !readValue(input, stored.minimum) || !readValue(input, stored.maximum)) {
+        return false;
+    }
+    uint64_t binnedCount = 0;
+    for (uint64_t& binCount : stored.histogram) {
+        if (!readValue(input, binCount)) {
+            return false;
+        }
+        binnedCount += binCount;
+    }
+    // every grade lands in one bin and one centroid, so the three counts agree
+    if (binnedCount != stored.count || !stored.digest.deserialize(input) ||
+        stored.digest.getCount() != static_cast<double>(stored.count)) {
+        return false;
+    }
+    *this = std::move(stored);
+    bytes = input;
+    return true;
+}
+
+double GradeStatistics::getVariance() const {
+    return count > 1 ? sumOfSquares / (count - 1) : 0.0;
+}
+
+double GradeStatistics::getStandardDeviation() const {
+    return std::sqrt(getVariance());
+}
+
+void CohortStatistics::addCourse(const Course& course) {
+    for (const AssessmentView& assessment : course.getAssessments()) {
+        if (assessment.getIsComplete()) {
+            byAssessmentName[assessment.getNameId()].add(assessment.getGrade());
+        }
+    }
+
+    if (course.getTotalWeight() > 0.0) {
+        double grade = course.calculateGradeSoFar(true);
+        allCourses.add(grade);
+        byCourseCode[course.getCourseCode()].add(grade);
+    }
+}
+
+void CohortStatistics::merge(const CohortStatistics& other) {
+    allCourses.merge(other.allCourses);
+    for (const auto& entry : other.byCourseCode) {
+        byCourseCode[entry.first].merge(entry.second);
+    }
+    for (const auto& entry : other.byAssessmentName) {
+        byAssessmentName[entry.first].merge(entry.second);
+    }
+}
+
+void CohortStatistics::compress() {
+    allCourses.compress();
+    for (auto& entry : byCourseCode) {
+        entry.second.compress();
+    }
+    for (auto& entry : byAssessmentName) {
+        entry.second.compress();
+    }
+}
+
+CohortStatistics CohortStatistics::compute(const std::vector<Course>& courses, unsigned threadCount) {
+    // small shards aren't worth a thread
+    const size_t minimumShardSize = 256;
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t shardCount = std::max<size_t>(1, std::min<size_t>(threadCount, courses.size() / minimumShardSize));
+
+    std::vector<CohortStatistics> shards(shardCount);
+    auto buildShard = [&courses, &shards, shardCount](size_t shard) {
+        size_t begin = courses.size() * shard / shardCount;
+        size_t end = courses.size() * (shard + 1) / shardCount;
+        for (size_t i = begin; i < end; i++) {
+            shards[shard].addCourse(courses[i]);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t shard = 1; shard < shardCount; shard++) {
+        workers.emplace_back(buildShard, shard);
+    }
+    buildShard(0); // the calling thread takes a shard too
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    CohortStatistics result = std::move(shards[0]);
+    for (size_t shard = 1; shard < shardCount; shard++) {
+        result.merge(shards[shard]);
+    }
+    result.compress();
+    return result;
+}
+
+// Serialisation: magic, version, the all-courses group, then every course code
+// and assessment name group sorted by key, each key as a length-prefixed string.
+std::string CohortStatistics::serialize() const {
+    std::string bytes(statisticsMagic, sizeof(statisticsMagic));
+    appendValue<uint32_t>(bytes, statisticsVersion);
+    allCourses.serialize(bytes);
+
+    std::vector<std::string> courseCodes = getCourseCodes();
+    appendValue<uint32_t>(bytes, static_cast<uint32_t>(courseCodes.size()));
+    for (const std::string& courseCode : courseCodes) {
+        appendString(bytes, courseCode);
+        byCourseCode.at(courseCode).serialize(bytes);
+    }
+
+    std::vector<std::string> names = getAssessmentNames();
+    appendValue<uint32_t>(bytes, static_cast<uint32_t>(names.size()));
+    for (const std::string& name : names) {
+        appendString(bytes, name);
+        getAssessmentStatistics(name)->serialize(bytes);
+    }
+    return bytes;
+}
+
+bool CohortStatistics::deserialize(std::string_view bytes) {
+    uint32_t version;
+    if (bytes.size() < sizeof(statisticsMagic) ||
+        std::memcmp(bytes.data(), statisticsMagic, sizeof(statisticsMagic)) != 0) {
+        return false;
+    }
+    bytes.remove_prefix(sizeof(statisticsMagic));
+    if (!readValue(bytes, version) || version != statisticsVersion) {
+        return false;
+    }
+
+    CohortStatistics stored;
+    uint32_t groupCount;
+    if (!stored.allCourses.deserialize(bytes) || !readValue(bytes, groupCount)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < groupCount; i++) {
+        std::string_view courseCode;
+        GradeStatistics statistics;
+        if (!readString(bytes, courseCode) || !statistics.deserialize(bytes)) {
+            return false;
+        }
+        stored.byCourseCode[std::string(courseCode)] = std::move(statistics);
+    }
+
+    if (!readValue(bytes, groupCount)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < groupCount; i++) {
+        std::string_view name;
+        GradeStatistics statistics;
+        if (!readString(bytes, name) || !statistics.deserialize(bytes)) {
+            return false;
+        }
+        // the writer's ids mean nothing here, the name finds this process's one
+        stored.byAssessmentName[NameTable::getShared().intern(name)] = std::move(statistics);
+    }
+    if (!bytes.empty()) {
+        return false;
+    }
+
+    *this = std::move(stored);
+    return true;
+}
+
+bool CohortStatistics::save(const std::string& filePath) const {
+    std::string bytes = serialize();
+    std::string tempPath = filePath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), bytes.size());
+        file.close();
+        if (!file.good() || !DurableFile::sync(tempPath)) {
+            std::cerr << "Error: Could not write statistics file at " << tempPath << std::endl;
+            return false;
+        }
+    }
+    if (!DurableFile::replace(tempPath, filePath)) {
+        std::cerr << "Error: Could not replace statistics file at " << filePath << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool CohortStatistics::load(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open statistics file at " << filePath << std::endl;
+        return false;
+    }
+    std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!deserialize(bytes)) {
+        std::cerr << "Error: " << filePath << " is not a valid statistics file" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+const GradeStatistics* CohortStatistics::getCourseCodeStatistics(const std::string& courseCode) const {
+    auto found = byCourseCode.find(courseCode);
+    return found != byCourseCode.end() ? &found->second : nullptr;
+}
+
+const GradeStatistics* CohortStatistics::getAssessmentStatistics(std::string_view name) const {
+    uint32_t id;
+    if (!NameTable::getShared().find(name, id)) {
+        return nullptr;
+    }
+    auto found = byAssessmentName.find(id);
+    return found != byAssessmentName.end() ? &found->second : nullptr;
+}
+
+std::vector<std::string> CohortStatistics::getCourseCodes() const {
+    std::vector<std::string> codes;
+    codes.reserve(byCourseCode.size());
+    for (const auto& entry : byCourseCode) {
+        codes.push_back(entry.first);
+    }
+    std::sort(codes.begin(), codes.end());
+    return codes;
+}
+
+std::vector<std::string> CohortStatistics::getAssessmentNames() const {
+    std::vector<std::string> names;
+    names.reserve(byAssessmentName.size());
+    for (const auto& entry : byAssessmentName) {
+        names.emplace_back(NameTable::getShared().getName(entry.first));
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
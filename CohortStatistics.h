@@ -0,0 +1,94 @@
+#ifndef COHORT_STATISTICS_H
+#define COHORT_STATISTICS_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Course.h"
+#include "TDigest.h"
+
+// Everything kept about one group of grades: count, mean and variance
+// (Welford's running update, merged with Chan's formula), a t-digest for
+// quantiles and a 5%-wide histogram. All of it is mergeable, so shards built on
+// different threads, or serialised by other processes, combine into the
+// statistics of the whole.
+class GradeStatistics {
+public:
+    static constexpr int binCount = 20; // [0, 5), [5, 10), ... [95, 100]
+
+private:
+    uint64_t count = 0;
+    double mean = 0.0;
+    double sumOfSquares = 0.0; // of differences from the mean
+    double minimum = 0.0;
+    double maximum = 0.0;
+    TDigest digest;
+    std::array<uint64_t, binCount> histogram{};
+
+public:
+    void add(double grade);
+    void merge(const GradeStatistics& other);
+    void compress() { digest.compress(); }
+
+    // binary form, see TDigest::serialize
+    void serialize(std::string& bytes) const;
+    bool deserialize(std::string_view& bytes);
+
+    //getter
+    uint64_t getCount() const { return count; }
+    double getMean() const { return mean; }
+    double getVariance() const;          // sample variance, 0 below two grades
+    double getStandardDeviation() const;
+    double getMinimum() const { return minimum; }
+    double getMaximum() const { return maximum; }
+    double getQuantile(double q) const { return digest.getQuantile(q); } // q in [0, 1]
+    // grades below 0 or above 100 are counted in the first or last bin
+    const std::array<uint64_t, binCount>& getHistogram() const { return histogram; }
+};
+
+// Statistics across many courses, possibly of many students: final grades per
+// course code and grades per assessment name, plus one group over all courses.
+// A course counts with its grade so far, which is its overall grade once every
+// assessment is done; courses with nothing completed yet are skipped, and so
+// are incomplete assessments. Assessment groups are keyed by NameTable id, so
+// adding a course never copies or hashes a name string. The ids only mean
+// something within this process, so the serialised form stores the names and
+// reading it interns them here again.
+class CohortStatistics {
+private:
+    GradeStatistics allCourses;
+    std::unordered_map<std::string, GradeStatistics> byCourseCode;
+    std::unordered_map<uint32_t, GradeStatistics> byAssessmentName;
+
+public:
+    void addCourse(const Course& course);
+    void merge(const CohortStatistics& other);
+    void compress(); // fold every digest's buffer in before a round of queries
+
+    // Shards from other processes or machines: serialize, ship, deserialize and
+    // merge. deserialize replaces the contents; false (nothing changed) if the
+    // bytes are truncated or corrupt. save and load do the same through a file.
+    std::string serialize() const;
+    bool deserialize(std::string_view bytes);
+    bool save(const std::string& filePath) const;
+    bool load(const std::string& filePath);
+
+    // One pass over courses split into contiguous shards, one per thread (0 = one
+    // per core), merged in shard order. The result is the same for the same
+    // thread count.
+    static CohortStatistics compute(const std::vector<Course>& courses, unsigned threadCount = 0);
+
+    //getter
+    const GradeStatistics& getAllCourses() const { return allCourses; }
+    // nullptr if no course or assessment by that code or name has a grade
+    const GradeStatistics* getCourseCodeStatistics(const std::string& courseCode) const;
+    const GradeStatistics* getAssessmentStatistics(std::string_view name) const;
+    // sorted keys, for reports
+    std::vector<std::string> getCourseCodes() const;
+    std::vector<std::string> getAssessmentNames() const;
+};
+
+#endif
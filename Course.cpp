@@ -1,47 +1,108 @@
 #include "Course.h"
+#include <algorithm>
 #include <cmath>
 
 Course::Course(std::string courseCode, std::vector<Assessment> assessments, bool isA5050Course) {
     this->courseCode = courseCode;
-    this->assessments = assessments;
+    this->assessments = AssessmentStore(assessments);
     this->isA5050Course = isA5050Course;
+    recomputeTotals();
+}
+
+// Running totals
+// one masked pass over the store's columns instead of a branch per assessment
+void Course::recomputeTotals() {
+    GradeKernels::sumBuckets(assessments.getWeightData(), assessments.getGradeData(),
+                             assessments.getTheoryMaskData(), assessments.getCompleteMaskData(),
+                             assessments.getCount(), totals);
+}
+
+void Course::addToTotals(int index) {
+    int isTheory = assessments.getIsTheory(index);
+    int isComplete = assessments.getIsComplete(index);
+    totals.weightedGrade[isTheory][isComplete] += assessments.getGrade(index) * assessments.getWeight(index);
+    totals.weight[isTheory][isComplete] += assessments.getWeight(index);
+    totals.count[isTheory][isComplete]++;
+}
+
+void Course::removeFromTotals(int index) {
+    int isTheory = assessments.getIsTheory(index);
+    int isComplete = assessments.getIsComplete(index);
+    totals.count[isTheory][isComplete]--;
+    if (totals.count[isTheory][isComplete] == 0) {
+        // drop any rounding residue once the bucket empties
+        totals.weightedGrade[isTheory][isComplete] = 0.0;
+        totals.weight[isTheory][isComplete] = 0.0;
+        return;
+    }
+    totals.weightedGrade[isTheory][isComplete] -= assessments.getGrade(index) * assessments.getWeight(index);
+    totals.weight[isTheory][isComplete] -= assessments.getWeight(index);
+}
+
+// sum the buckets selected by careForComplete, optionally restricted to one section
+void Course::sumTotals(const BucketSums& totals, bool careForComplete, int section, double& weightedGrade,
+                       double& weight) {
+    weightedGrade = 0.0;
+    weight = 0.0;
+
+    for (int isTheory = 0; isTheory < 2; isTheory++) {
+        if (section >= 0 && isTheory != section) {
+            continue;
+        }
+        for (int isComplete = careForComplete ? 1 : 0; isComplete < 2; isComplete++) {
+            weightedGrade += totals.weightedGrade[isTheory][isComplete];
+            weight += totals.weight[isTheory][isComplete];
+        }
+    }
 }
 
 std::string Course::getCourseCode() const {
     return courseCode;
 }
 
+AssessmentRange Course::getAssessments() const {
+    return AssessmentRange(&assessments);
+}
+
 std::vector<Assessment> Course::getAllAssessments() const {
-    return assessments;
+    return assessments.toVector();
 }
 
 void Course::updateAssessmentName(int index, const std::string& newName) {
-    if (index >= 0 && index < static_cast<int>(assessments.size())) {
-        assessments[index].setName(newName);
+    if (index >= 0 && index < assessments.getCount()) {
+        assessments.setName(index, newName);
     }
 }
 
 void Course::updateAssessmentWeight(int index, double newWeight) {
-    if (index >= 0 && index < static_cast<int>(assessments.size())) {
-        assessments[index].setWeight(newWeight);
+    if (index >= 0 && index < assessments.getCount()) {
+        removeFromTotals(index);
+        assessments.setWeight(index, newWeight);
+        addToTotals(index);
     }
 }
 
 void Course::updateAssessmentType(int index, bool isTheory) {
-    if (index >= 0 && index < static_cast<int>(assessments.size())) {
-        assessments[index].setIsTheory(isTheory);
+    if (index >= 0 && index < assessments.getCount()) {
+        removeFromTotals(index);
+        assessments.setIsTheory(index, isTheory);
+        addToTotals(index);
     }
 }
 
 void Course::updateAssessmentCompletionStatus(int index, bool isComplete) {
-    if (index >= 0 && index < static_cast<int>(assessments.size())) {
-        assessments[index].setIsComplete(isComplete);
+    if (index >= 0 && index < assessments.getCount()) {
+        removeFromTotals(index);
+        assessments.setIsComplete(index, isComplete);
+        addToTotals(index);
     }
 }
 
 void Course::updateAssessmentGrade(int index, double newGrade) {
-    if (index >= 0 && index < static_cast<int>(assessments.size())) {
-        assessments[index].setGrade(newGrade);
+    if (index >= 0 && index < assessments.getCount()) {
+        removeFromTotals(index);
+        assessments.setGrade(index, newGrade);
+        addToTotals(index);
     }
 }
 
@@ -54,69 +115,76 @@ void Course::setCourseCode(std::string newCourseCode) {
 }
 
 void Course::setAssessments(std::vector<Assessment> newAssessments) {
-    assessments = newAssessments;
+    assessments = AssessmentStore(newAssessments);
+    recomputeTotals();
 }
 
 void Course::setIsA5050Course(bool newIsA5050Course) {
     isA5050Course = newIsA5050Course;
 }
 
+double Course::getCredits() const {
+    return credits;
+}
+
+const std::string& Course::getTerm() const {
+    return term;
+}
+
+void Course::setCredits(double newCredits) {
+    credits = newCredits;
+}
+
+void Course::setTerm(std::string newTerm) {
+    term = std::move(newTerm);
+}
+
 // Assessment Management
 void Course::addAssessment(const Assessment& assessment) {
-    assessments.push_back(assessment);
+    assessments.add(assessment);
+    addToTotals(assessments.getCount() - 1);
 }
 
 void Course::removeAssessment(int index) {
-    if (index >= 0 && index < assessments.size()) {
-        assessments.erase(assessments.begin() + index);
+    if (index >= 0 && index < assessments.getCount()) {
+        removeFromTotals(index);
+        assessments.remove(index);
     }
 }
 
-Assessment& Course::getAssessment(int index) {
-    return assessments[index];
+const Assessment Course::getAssessment(int index) const {
+    return assessments.getAssessment(index);
 }
 
 int Course::getAssessmentCount() const {
-    return assessments.size();
+    return assessments.getCount();
 }
 
 int Course::getIncompleteAssessmentCount() const {
-    int count = 0;
-    for (const Assessment& assessment : assessments) {
-        if (!assessment.getIsComplete()) {
-            count++;
-        }
-    }
-    return count;
+    return totals.count[0][0] + totals.count[1][0];
 }
 
 double Course::getTotalWeight() const {
-    double totalWeight = 0.0;
-
-    for (const Assessment& assessment : assessments) {
-        if (assessment.getIsComplete()) {
-            totalWeight += assessment.getWeight();
-        }
-    }
-
-    return totalWeight;
+    return totals.weight[0][1] + totals.weight[1][1];
 }
 
 bool Course::isTotalWeightValid() const {
-    double totalWeight = getTotalWeight();
-    return totalWeight == 100.0;
+    return isTotalWeightValid(totals);
+}
+
+bool Course::isTotalWeightValid(const BucketSums& totals) {
+    double totalWeight = totals.weight[0][1] + totals.weight[1][1];
+    return std::abs(totalWeight - 100.0) < weightTolerance;
 }
 
 double Course::calculateOverallGrade(bool careForComplete) const {
-    double myGradesWeighted = 0.0;
-    double totalWeight = 0.0;
+    return calculateOverallGrade(totals, careForComplete);
+}
 
-    for(const Assessment& assessment : assessments) {
-        if (!careForComplete || assessment.getIsComplete()) {
-            myGradesWeighted += assessment.getGrade() * assessment.getWeight();
-            totalWeight += assessment.getWeight();
-        }
-    }
+double Course::calculateOverallGrade(const BucketSums& totals, bool careForComplete) {
+    double myGradesWeighted;
+    double totalWeight;
+    sumTotals(totals, careForComplete, -1, myGradesWeighted, totalWeight);
 
     if (totalWeight == 0.0) {
         return 0.0;
@@ -128,15 +196,17 @@ double Course::calculateOverallGrade(bool careForComplete) const {
 }
 
 double Course::calculateGradeSoFar(bool careForComplete) const {
-    double myGradesWeighted = 0.0;
-    double totalWeight = 0.0;
+    return calculateGradeSoFar(totals, careForComplete, -1);
+}
 
-    for(const Assessment& assessment : assessments) {
-        if (!careForComplete || assessment.getIsComplete()) {
-            myGradesWeighted += assessment.getGrade() * assessment.getWeight();
-            totalWeight += assessment.getWeight();
-        }
-    }
+double Course::calculateSectionGradeSoFar(bool isTheory, bool careForComplete) const {
+    return calculateGradeSoFar(totals, careForComplete, isTheory ? 1 : 0);
+}
+
+double Course::calculateGradeSoFar(const BucketSums& totals, bool careForComplete, int section) {
+    double myGradesWeighted;
+    double totalWeight;
+    sumTotals(totals, careForComplete, section, myGradesWeighted, totalWeight);
 
     if (totalWeight == 0.0) {
         return 0.0;
@@ -147,107 +217,124 @@ double Course::calculateGradeSoFar(bool careForComplete) const {
     return std::round(result * 100) / 100; //round two dec pts
 }
 
-double Course::calculateSectionGradeSoFar(bool isTheory, bool careForComplete) const {
-    double myGradesWeighted = 0.0;
-    double totalWeight = 0.0;
+GradeSummary Course::calculateSummary(bool careForComplete) const {
+    return calculateSummary(totals, careForComplete);
+}
 
-    for(const Assessment& assessment : assessments) {
-        if ((!careForComplete || assessment.getIsComplete()) && assessment.getIsTheory() == isTheory) {
-            myGradesWeighted += assessment.getGrade() * assessment.getWeight();
-            totalWeight += assessment.getWeight();
-        }
+GradeSummary Course::calculateSummary(const BucketSums& totals, bool careForComplete) {
+    GradeSummary summary;
+    summary.overallGrade = calculateOverallGrade(totals, careForComplete);
+    summary.gradeSoFar = calculateGradeSoFar(totals, careForComplete, -1);
+    summary.theoryGrade = calculateGradeSoFar(totals, careForComplete, 1);
+    summary.labGrade = calculateGradeSoFar(totals, careForComplete, 0);
+    summary.completeWeight = totals.weight[0][1] + totals.weight[1][1];
+    summary.incompleteCount = totals.count[0][0] + totals.count[1][0];
+    summary.isTotalWeightValid = isTotalWeightValid(totals);
+    return summary;
+}
+
+// earned + x * remaining / 100 = goal, solved for the uniform grade x
+double Course::solveUniformGrade(double earnedPoints, double remainingWeight, double goalGrade, bool& isAchievable) {
+    // nothing left to write, the goal is either already met or out of reach
+    if (remainingWeight <= 0.0) {
+        isAchievable = earnedPoints + requiredGradeTolerance >= goalGrade;
+        return 0.0;
     }
 
-    if (totalWeight == 0.0) {
+    double required = (goalGrade - earnedPoints) * 100 / remainingWeight;
+
+    // every remaining item shares the same [0, 100] bounds, so they all saturate
+    // together: below 0 the goal is already secured, above 100 it can't be reached
+    if (required <= 0.0) {
+        isAchievable = true;
         return 0.0;
     }
 
-    double result = myGradesWeighted / totalWeight;
+    // a requirement within the tolerance of 100% is float noise from the summed
+    // weights, not a goal out of reach
+    if (required > 100.0 + requiredGradeTolerance) {
+        isAchievable = false;
+        return required;
+    }
 
-    return std::round(result * 100) / 100; //round two dec pts
+    double rounded = std::ceil(required * 100 - 1e-9) / 100; // round up so the goal is still met
+    isAchievable = true;
+    return std::min(rounded, 100.0);
 }
 
-std::vector<Assessment> Course::calculateRequiredGrades(double goalGrade) const {
+double Course::calculateRequiredUniformGrade(double goalGrade, bool& isAchievable) const {
+    return calculateRequiredUniformGrade(totals, goalGrade, isAchievable);
+}
+
+double Course::calculateRequiredUniformGrade(const BucketSums& totals, double goalGrade, bool& isAchievable) {
+    // weighted points already banked (out of 100) and the weight still to be written
+    double earnedPoints = (totals.weightedGrade[0][1] + totals.weightedGrade[1][1]) / 100;
+    double remainingWeight = totals.weight[0][0] + totals.weight[1][0];
+    return solveUniformGrade(earnedPoints, remainingWeight, goalGrade, isAchievable);
+}
+
+void Course::calculateRequiredUniformGrades(const std::vector<double>& goals, double* requiredGrades,
+                                            uint8_t* isAchievable) const {
+    calculateRequiredUniformGrades(totals, goals, requiredGrades, isAchievable);
+}
 
-    const double threshold = 0.1; //how close is the projection to the goal
-    const double interval = 0.5; // increment interval
+void Course::calculateRequiredUniformGrades(const BucketSums& totals, const std::vector<double>& goals,
+                                            double* requiredGrades, uint8_t* isAchievable) {
+    double earnedPoints = (totals.weightedGrade[0][1] + totals.weightedGrade[1][1]) / 100;
+    double remainingWeight = totals.weight[0][0] + totals.weight[1][0];
+    for (size_t i = 0; i < goals.size(); i++) {
+        bool achievable;
+        requiredGrades[i] = solveUniformGrade(earnedPoints, remainingWeight, goals[i], achievable);
+        isAchievable[i] = achievable ? 1 : 0;
+    }
+}
 
-    if (isTotalWeightValid()) {
-        return getAllAssessments(); // returns same
+RequiredGradeMatrix Course::calculateRequiredUniformGrades(const std::vector<double>& goals) const {
+    RequiredGradeMatrix matrix(goals, 1);
+    calculateRequiredUniformGrades(matrix.goals, matrix.getRow(0), matrix.getAchievableRow(0));
+    return matrix;
+}
+
+std::vector<double> RequiredGradeMatrix::makeGoalRange(double first, double last, double step) {
+    std::vector<double> range;
+    if (step <= 0.0 || last < first) {
+        return range;
+    }
+    // counted rather than accumulated, so 50 + 50 * 1.0 lands exactly on 100
+    int count = static_cast<int>(std::floor((last - first) / step + 1e-9)) + 1;
+    range.reserve(count);
+    for (int i = 0; i < count; i++) {
+        range.push_back(first + i * step);
     }
+    return range;
+}
 
-    double gradeSoFar = calculateOverallGrade(true);
+std::vector<Assessment> Course::calculateRequiredGrades(double goalGrade, bool& isAchievable) const {
     std::vector<Assessment> assessmentsCopy = getAllAssessments();
-    
-    if (std::abs(goalGrade - gradeSoFar) < threshold) {
+
+    double required = calculateRequiredUniformGrade(goalGrade, isAchievable);
+    if (!isAchievable) {
         return assessmentsCopy;
     }
-    
-    double increment;
-    
-    auto calculateProjectedGrade = [](const std::vector<Assessment>& assessments) -> double {
-        double weightedSum = 0.0;
-        double totalWeight = 0.0;
-        
-        for (const Assessment& assessment : assessments) {
-            // Include all assessments in the calculation
-            weightedSum += assessment.getGrade() * assessment.getWeight();
-            totalWeight += assessment.getWeight();
-        }
-        
-        if (totalWeight == 0.0) {
-            return 0.0;
-        }
-        
-        return std::round((weightedSum / 100) * 100) / 100; // Round to 2 decimal places
-    };
-    
-    // Initial setup for incomplete assessments
+
     for (Assessment& assessment : assessmentsCopy) {
         if (!assessment.getIsComplete()) {
-            // Start with a reasonable grade if currently 0
-            if (assessment.getGrade() == 0.0) {
-                assessment.setGrade(50.0);
-            }
+            assessment.setGrade(required);
         }
     }
-    
-    double projectedGrade = calculateProjectedGrade(assessmentsCopy);
-    
-    int maxIterations = 1000; // Safety against infinite loops
-    int iteration = 0;
-    
-    while (std::abs(goalGrade - projectedGrade) > threshold && iteration < maxIterations) {
-        for (Assessment& assessment : assessmentsCopy) {
-            if (!assessment.getIsComplete()) {
-                // Update the grade
-                increment = (goalGrade > projectedGrade) ? interval : -interval;
-                double newGrade = assessment.getGrade() + increment;
-                
-                // Keep grades within reasonable bounds (0-100%)
-                if (newGrade >= 0.0 && newGrade <= 100.0) {
-                    assessment.setGrade(newGrade);
-                }
-            }
-        }
-        
-        // Recalculate the projected grade
-        projectedGrade = calculateProjectedGrade(assessmentsCopy);
-        iteration++;
-    }
-    
-    //set all to now completed for analysis printing
-    // for (Assessment& assessment : assessmentsCopy) {
-    //     if (!assessment.getIsComplete()) {
-    //         assessment.setIsComplete(true);
-    //     }
-    // }
-
-    if (iteration >= maxIterations) {
+
+    return assessmentsCopy;
+}
+
+std::vector<Assessment> Course::calculateRequiredGrades(double goalGrade) const {
+    bool isAchievable;
+    std::vector<Assessment> result = calculateRequiredGrades(goalGrade, isAchievable);
+
+    if (!isAchievable) {
         return std::vector<Assessment>();
     }
 
-    return assessmentsCopy;
+    return result;
 }
 
 std::vector<Assessment> Course::calculateWhatIf() const {
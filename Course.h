@@ -1,37 +1,105 @@
 #ifndef COURSE_H
 #define COURSE_H
 
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 #include "Assessment.h"
+#include "AssessmentStore.h"
+#include "GradeKernels.h"
+
+// Everything the course views report, read in one call from the running totals.
+// Each field matches the value of the standalone method of the same meaning.
+struct GradeSummary {
+    double overallGrade;       // calculateOverallGrade
+    double gradeSoFar;         // calculateGradeSoFar
+    double theoryGrade;        // calculateSectionGradeSoFar(true, ...)
+    double labGrade;           // calculateSectionGradeSoFar(false, ...)
+    double completeWeight;     // getTotalWeight
+    int incompleteCount;       // getIncompleteAssessmentCount
+    bool isTotalWeightValid;   // isTotalWeightValid
+};
+
+// Required uniform grades for a list of goals over a list of courses, row-major:
+// row c holds course c's answers for goals[0..goals.size()). The entries follow
+// Course::calculateRequiredUniformGrade for that course and goal.
+struct RequiredGradeMatrix {
+    std::vector<double> goals;
+    int courseCount = 0;
+    std::vector<double> requiredGrades;
+    std::vector<uint8_t> isAchievable; // 0 or 1
+
+    RequiredGradeMatrix() = default;
+    RequiredGradeMatrix(std::vector<double> goals, int courseCount)
+        : goals(std::move(goals)), courseCount(courseCount),
+          requiredGrades(this->goals.size() * courseCount), isAchievable(this->goals.size() * courseCount) {}
+
+    size_t getGoalCount() const { return goals.size(); }
+    double* getRow(int course) { return requiredGrades.data() + course * goals.size(); }
+    uint8_t* getAchievableRow(int course) { return isAchievable.data() + course * goals.size(); }
+    double getRequiredGrade(int course, size_t goal) const { return requiredGrades[course * goals.size() + goal]; }
+    bool getIsAchievable(int course, size_t goal) const { return isAchievable[course * goals.size() + goal] != 0; }
+
+    // first, first + step, ... up to and including last (within rounding)
+    static std::vector<double> makeGoalRange(double first, double last, double step);
+};
 
 class Course {
 private:
 
     std::string courseCode;
-    std::vector<Assessment> assessments;
+    AssessmentStore assessments; // SoA backing store, Assessment objects are only built on demand
     bool isA5050Course;
+    double credits = defaultCredits; // weight of the course in a GPA
+    std::string term;                // e.g. "2025-09"; empty when not set
+
+    // Running weighted-grade and weight sums per [isTheory][isComplete] bucket, kept
+    // up to date by every mutator so the grade queries below are O(1) reads.
+    BucketSums totals;
+
+    void recomputeTotals();
+    void addToTotals(int index);
+    void removeFromTotals(int index);
+    static void sumTotals(const BucketSums& totals, bool careForComplete, int section, double& weightedGrade,
+                          double& weight);
+    static double calculateOverallGrade(const BucketSums& totals, bool careForComplete);
+    static double calculateGradeSoFar(const BucketSums& totals, bool careForComplete, int section); // -1 = both
+    static bool isTotalWeightValid(const BucketSums& totals);
+
+    static constexpr double requiredGradeTolerance = 0.005; // half of the displayed 0.01%
+    static constexpr double weightTolerance = 1e-9; // absorbs drift in the running weight sums
+
+    static double solveUniformGrade(double earnedPoints, double remainingWeight, double goalGrade, bool& isAchievable);
 
 public:
+    static constexpr double defaultCredits = 1.0;
 
     //constructor
     Course(std::string courseCode, std::vector<Assessment> assessments, bool isA5050Course);
 
     //getter
     std::string getCourseCode() const;
-    std::vector<Assessment> getAllAssessments() const;
+    AssessmentRange getAssessments() const; // non-owning view, no copies
+    std::vector<Assessment> getAllAssessments() const; // owning copy, for scratch edits
     bool getIsA5050Course() const;
+    double getCredits() const;
+    const std::string& getTerm() const;
 
     //setter
     void setCourseCode(std::string newCourseCode);
     void setAssessments(std::vector<Assessment> newAssessments);
     void setIsA5050Course(bool newIsA5050Course);
+    void setCredits(double newCredits);
+    void setTerm(std::string newTerm);
 
     //assessment management
     void addAssessment(const Assessment& assessment);
     void removeAssessment(int index);
-    Assessment& getAssessment(int index);
+    // A copy, const so that getAssessment(i).setGrade(x) no longer compiles now
+    // that it would edit a temporary: edit through updateAssessment* instead.
+    const Assessment getAssessment(int index) const;
 
     void updateAssessmentName(int index, const std::string& newName);
     void updateAssessmentWeight(int index, double newWeight);
@@ -47,8 +115,25 @@ public:
 
     double calculateGradeSoFar(bool careForComplete) const;
     double calculateSectionGradeSoFar(bool isTheory, bool careForComplete) const;
+    GradeSummary calculateSummary(bool careForComplete) const;
 
-    std::vector<Assessment> calculateRequiredGrades(double goal) const;
+    // Closed-form solve for the single grade every incomplete assessment needs so the
+    // overall grade reaches goal. isAchievable is false when even 100% on all of them
+    // falls short; a goal that is already secured needs 0%.
+    double calculateRequiredUniformGrade(double goal, bool& isAchievable) const;
+    // The same for every goal at once: the banked points and remaining weight are
+    // summed once and each goal costs a few flops. Writes goals.size() entries.
+    void calculateRequiredUniformGrades(const std::vector<double>& goals, double* requiredGrades,
+                                        uint8_t* isAchievable) const;
+    RequiredGradeMatrix calculateRequiredUniformGrades(const std::vector<double>& goals) const; // one row
+    // The same queries over bucket sums gathered elsewhere, such as from a mapped
+    // snapshot's columns, so they need no Course.
+    static GradeSummary calculateSummary(const BucketSums& totals, bool careForComplete);
+    static double calculateRequiredUniformGrade(const BucketSums& totals, double goal, bool& isAchievable);
+    static void calculateRequiredUniformGrades(const BucketSums& totals, const std::vector<double>& goals,
+                                               double* requiredGrades, uint8_t* isAchievable);
+    std::vector<Assessment> calculateRequiredGrades(double goal, bool& isAchievable) const;
+    std::vector<Assessment> calculateRequiredGrades(double goal) const; // empty when impossible
     std::vector<Assessment> calculateWhatIf() const;
 
 };
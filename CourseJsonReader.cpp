@@ -0,0 +1,325 @@
+#include "CourseJsonReader.h"
+#include <stdexcept>
+
+namespace {
+
+const unsigned courseCodeField = 1u << 0;
+const unsigned courseIs5050Field = 1u << 1;
+const unsigned courseAssessmentsField = 1u << 2;
+const unsigned allCourseFields = courseCodeField | courseIs5050Field | courseAssessmentsField;
+
+const unsigned assessmentNameField = 1u << 0;
+const unsigned assessmentWeightField = 1u << 1;
+const unsigned assessmentGradeField = 1u << 2;
+const unsigned assessmentTheoryField = 1u << 3;
+const unsigned assessmentCompleteField = 1u << 4;
+const unsigned allAssessmentFields = assessmentNameField | assessmentWeightField | assessmentGradeField |
+                                     assessmentTheoryField | assessmentCompleteField;
+
+} // namespace
+
+void CourseJsonReader::read(std::istream& input, std::vector<Course>& courses) {
+    uint64_t revision;
+    read(input, courses, revision);
+}
+
+void CourseJsonReader::read(std::istream& input, std::vector<Course>& courses, uint64_t& revision) {
+    std::vector<Course> loaded;
+    CourseJsonReader reader(loaded);
+    nlohmann::json::sax_parse(input, &reader);
+    courses = std::move(loaded);
+    revision = reader.revision;
+}
+
+void CourseJsonReader::fail(const std::string& message) const {
+    std::string where = currentKey.empty() ? "" : " (at key '" + currentKey + "')";
+    throw std::runtime_error(message + where);
+}
+
+// Containers
+bool CourseJsonReader::beginContainer(bool isObject) {
+    if (skipDepth > 0) {
+        skipDepth++;
+        return true;
+    }
+
+    if (contexts.empty()) {
+        if (!isObject) {
+            fail("top level of the course file must be an object");
+        }
+        contexts.push_back(Context::RootObject);
+        return true;
+    }
+
+    switch (current()) {
+        case Context::RootObject:
+            if (currentKey == "courses") {
+                if (isObject) {
+                    fail("type must be array");
+                }
+                contexts.push_back(Context::CoursesArray);
+                return true;
+            }
+            break;
+
+        case Context::CoursesArray:
+            if (!isObject) {
+                fail("each course must be an object");
+            }
+            courseCode.clear();
+            isA5050Course = false;
+            credits = Course::defaultCredits;
+            term.clear();
+            assessments.clear();
+            courseFields = 0;
+            contexts.push_back(Context::CourseObject);
+            return true;
+
+        case Context::CourseObject:
+            if (currentKey == "assessments") {
+                if (isObject) {
+                    fail("type must be array");
+                }
+                courseFields |= courseAssessmentsField;
+                contexts.push_back(Context::AssessmentsArray);
+                return true;
+            }
+            if (currentKey == "courseCode" || currentKey == "isA5050Course" || currentKey == "credits" ||
+                currentKey == "term") {
+                fail(isObject ? "unexpected object" : "unexpected array");
+            }
+            break;
+
+        case Context::AssessmentsArray:
+            if (!isObject) {
+                fail("each assessment must be an object");
+            }
+            name.clear();
+            weight = 0.0;
+            grade = 0.0;
+            isTheory = true;
+            isComplete = false;
+            assessmentFields = 0;
+            contexts.push_back(Context::AssessmentObject);
+            return true;
+
+        case Context::AssessmentObject:
+            if (currentKey == "name" || currentKey == "weight" || currentKey == "grade" ||
+                currentKey == "isTheory" || currentKey == "isComplete") {
+                fail(isObject ? "unexpected object" : "unexpected array");
+            }
+            break;
+    }
+
+    // value of a key we don't use: skip it and everything nested inside
+    skipDepth = 1;
+    return true;
+}
+
+bool CourseJsonReader::start_object(std::size_t) {
+    return beginContainer(true);
+}
+
+bool CourseJsonReader::start_array(std::size_t) {
+    return beginContainer(false);
+}
+
+bool CourseJsonReader::end_object() {
+    if (skipDepth > 0) {
+        skipDepth--;
+        return true;
+    }
+
+    Context finished = current();
+    contexts.pop_back();
+    currentKey.clear();
+
+    if (finished == Context::AssessmentObject) {
+        if (assessmentFields != allAssessmentFields) {
+            fail("assessment is missing a required field");
+        }
+        assessments.emplace_back(name, weight, grade, isTheory, isComplete);
+    } else if (finished == Context::CourseObject) {
+        if (courseFields != allCourseFields) {
+            fail("course is missing a required field");
+        }
+        courses.emplace_back(courseCode, std::move(assessments), isA5050Course);
+        courses.back().setCredits(credits);
+        courses.back().setTerm(std::move(term));
+        assessments.clear();
+    }
+    return true;
+}
+
+bool CourseJsonReader::end_array() {
+    if (skipDepth > 0) {
+        skipDepth--;
+        return true;
+    }
+    contexts.pop_back();
+    currentKey.clear();
+    return true;
+}
+
+bool CourseJsonReader::key(string_t& val) {
+    if (skipDepth == 0) {
+        currentKey = val;
+    }
+    return true;
+}
+
+// Scalars
+bool CourseJsonReader::setNumber(double value) {
+    if (skipDepth > 0) {
+        return true;
+    }
+    if (contexts.empty() || current() == Context::CoursesArray || current() == Context::AssessmentsArray) {
+        fail("unexpected number");
+    }
+
+    if (current() == Context::AssessmentObject) {
+        if (currentKey == "weight") {
+            weight = value;
+            assessmentFields |= assessmentWeightField;
+        } else if (currentKey == "grade") {
+            grade = value;
+            assessmentFields |= assessmentGradeField;
+        } else if (currentKey == "name") {
+            fail("type must be string, but is number");
+        } else if (currentKey == "isTheory" || currentKey == "isComplete") {
+            fail("type must be boolean, but is number");
+        }
+    } else if (current() == Context::CourseObject) {
+        if (currentKey == "credits") {
+            credits = value;
+        } else if (currentKey == "courseCode" || currentKey == "term") {
+            fail("type must be string, but is number");
+        } else if (currentKey == "isA5050Course") {
+            fail("type must be boolean, but is number");
+        } else if (currentKey == "assessments") {
+            fail("type must be array, but is number");
+        }
+    } else if (currentKey == "courses") {
+        fail("type must be array, but is number");
+    }
+    return true;
+}
+
+bool CourseJsonReader::number_integer(number_integer_t val) {
+    if (skipDepth == 0 && contexts.size() == 1 && currentKey == "revision") {
+        revision = val < 0 ? 0 : static_cast<uint64_t>(val);
+        return true;
+    }
+    return setNumber(static_cast<double>(val));
+}
+
+bool CourseJsonReader::number_unsigned(number_unsigned_t val) {
+    if (skipDepth == 0 && contexts.size() == 1 && currentKey == "revision") {
+        revision = val;
+        return true;
+    }
+    return setNumber(static_cast<double>(val));
+}
+
+bool CourseJsonReader::number_float(number_float_t val, const string_t&) {
+    return setNumber(val);
+}
+
+bool CourseJsonReader::boolean(bool val) {
+    if (skipDepth > 0) {
+        return true;
+    }
+    if (contexts.empty() || current() == Context::CoursesArray || current() == Context::AssessmentsArray) {
+        fail("unexpected boolean");
+    }
+
+    if (current() == Context::AssessmentObject) {
+        if (currentKey == "isTheory") {
+            isTheory = val;
+            assessmentFields |= assessmentTheoryField;
+        } else if (currentKey == "isComplete") {
+            isComplete = val;
+            assessmentFields |= assessmentCompleteField;
+        } else if (currentKey == "name") {
+            fail("type must be string, but is boolean");
+        } else if (currentKey == "weight" || currentKey == "grade") {
+            fail("type must be number, but is boolean");
+        }
+    } else if (current() == Context::CourseObject) {
+        if (currentKey == "isA5050Course") {
+            isA5050Course = val;
+            courseFields |= courseIs5050Field;
+        } else if (currentKey == "courseCode" || currentKey == "term") {
+            fail("type must be string, but is boolean");
+        } else if (currentKey == "credits") {
+            fail("type must be number, but is boolean");
+        } else if (currentKey == "assessments") {
+            fail("type must be array, but is boolean");
+        }
+    } else if (currentKey == "courses") {
+        fail("type must be array, but is boolean");
+    }
+    return true;
+}
+
+bool CourseJsonReader::string(string_t& val) {
+    if (skipDepth > 0) {
+        return true;
+    }
+    if (contexts.empty() || current() == Context::CoursesArray || current() == Context::AssessmentsArray) {
+        fail("unexpected string");
+    }
+
+    if (current() == Context::AssessmentObject) {
+        if (currentKey == "name") {
+            name = std::move(val);
+            assessmentFields |= assessmentNameField;
+        } else if (currentKey == "weight" || currentKey == "grade") {
+            fail("type must be number, but is string");
+        } else if (currentKey == "isTheory" || currentKey == "isComplete") {
+            fail("type must be boolean, but is string");
+        }
+    } else if (current() == Context::CourseObject) {
+        if (currentKey == "courseCode") {
+            courseCode = std::move(val);
+            courseFields |= courseCodeField;
+        } else if (currentKey == "term") {
+            term = std::move(val);
+        } else if (currentKey == "credits") {
+            fail("type must be number, but is string");
+        } else if (currentKey == "isA5050Course") {
+            fail("type must be boolean, but is string");
+        } else if (currentKey == "assessments") {
+            fail("type must be array, but is string");
+        }
+    } else if (currentKey == "courses") {
+        fail("type must be array, but is string");
+    }
+    return true;
+}
+
+// null "courses"/"assessments" mean an empty list, as the DOM loader treated them
+bool CourseJsonReader::null() {
+    if (skipDepth > 0 || contexts.empty()) {
+        return true;
+    }
+    if (current() == Context::CourseObject && currentKey == "assessments") {
+        courseFields |= courseAssessmentsField;
+    } else if (current() == Context::CourseObject || current() == Context::AssessmentObject) {
+        if (currentKey == "courseCode" || currentKey == "isA5050Course" || currentKey == "name" ||
+            currentKey == "weight" || currentKey == "grade" || currentKey == "isTheory" || currentKey == "isComplete") {
+            fail("unexpected null");
+        }
+    } else if (current() == Context::CoursesArray || current() == Context::AssessmentsArray) {
+        fail("unexpected null");
+    }
+    return true;
+}
+
+bool CourseJsonReader::binary(binary_t&) {
+    return true; // never produced by the text parser
+}
+
+bool CourseJsonReader::parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) {
+    throw std::runtime_error(ex.what());
+}
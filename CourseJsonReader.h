@@ -0,0 +1,68 @@
+#ifndef COURSE_JSON_READER_H
+#define COURSE_JSON_READER_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "Course.h"
+
+// Streaming reader for the courses.json layout. It is driven by nlohmann's SAX
+// interface and builds Assessment and Course objects as the tokens arrive, so no
+// JSON DOM is ever held in memory. Throws on malformed input like the DOM did.
+class CourseJsonReader : public nlohmann::json_sax<nlohmann::json> {
+private:
+    enum class Context { RootObject, CoursesArray, CourseObject, AssessmentsArray, AssessmentObject };
+
+    std::vector<Course>& courses;
+    uint64_t revision = 0;
+    std::vector<Context> contexts;
+    std::string currentKey;
+    int skipDepth = 0; // >0 while inside the value of a key we don't know
+
+    // fields of the course/assessment currently being read, with presence bits
+    std::string courseCode;
+    bool isA5050Course = false;
+    double credits = Course::defaultCredits; // optional, like term
+    std::string term;
+    std::vector<Assessment> assessments;
+    unsigned courseFields = 0;
+
+    std::string name;
+    double weight = 0.0;
+    double grade = 0.0;
+    bool isTheory = true;
+    bool isComplete = false;
+    unsigned assessmentFields = 0;
+
+    Context current() const { return contexts.back(); }
+    bool beginContainer(bool isObject);
+    bool setNumber(double value);
+    [[noreturn]] void fail(const std::string& message) const;
+
+public:
+    explicit CourseJsonReader(std::vector<Course>& courses) : courses(courses) {}
+
+    // parse a whole courses.json stream into courses (replacing its contents);
+    // revision is the optional top-level "revision" written alongside the journal
+    static void read(std::istream& input, std::vector<Course>& courses);
+    static void read(std::istream& input, std::vector<Course>& courses, uint64_t& revision);
+
+    bool null() override;
+    bool boolean(bool val) override;
+    bool number_integer(number_integer_t val) override;
+    bool number_unsigned(number_unsigned_t val) override;
+    bool number_float(number_float_t val, const string_t& s) override;
+    bool string(string_t& val) override;
+    bool binary(binary_t& val) override;
+    bool start_object(std::size_t elements) override;
+    bool key(string_t& val) override;
+    bool end_object() override;
+    bool start_array(std::size_t elements) override;
+    bool end_array() override;
+    bool parse_error(std::size_t position, const std::string& last_token,
+                     const nlohmann::detail::exception& ex) override;
+};
+
+#endif
@@ -1,43 +1,703 @@
 #include "CourseManager.h"
+#include "CourseJsonReader.h"
+#include "CourseSnapshot.h"
+#include "DurableFile.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
 #include <fstream>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
-CourseManager::CourseManager(const std::string& filePath) : dataFilePath(filePath) {
+CourseManager::CourseManager(const std::string& filePath, bool readOnly)
+    : dataFilePath(filePath), readOnly(readOnly), journal(getJournalFilePath()) {
     //load saved courses when called
     loadFromFile();
 }
 
+CourseManager::~CourseManager() {
+    stopFlushTimer();
+    if (!readOnly) {
+        flush(); // read-only managers never write behind the caller's back
+    }
+}
+
 void CourseManager::addCourse(const Course& course) {
-    courses.push_back(course);
-    saveToFile();
+    JournalRecord record;
+    record.type = JournalRecord::Type::AddCourse;
+    record.text = course.getCourseCode();
+    record.flag = course.getIsA5050Course();
+    record.number = course.getCredits();
+    record.term = course.getTerm();
+    record.assessments = course.getAllAssessments();
+    recordEdit(std::move(record));
 }
 
 void CourseManager::removeCourse(int index) {
-    if (index >= 0 && index < courses.size()) {
-        courses.erase(courses.begin() + index);
-        saveToFile();
-    }
+    JournalRecord record;
+    record.type = JournalRecord::Type::RemoveCourse;
+    record.courseIndex = index;
+    recordEdit(std::move(record));
 }
 
 Course& CourseManager::getCourse(int index) {
+    materialise(); // the caller may edit, so hand out an owning Course
     return courses[index];
 }
 
 int CourseManager::getCourseCount() const {
+    std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+    if (mappedSnapshot) {
+        return mappedSnapshot->getCourseCount();
+    }
     return courses.size();
 }
 
+// code lookups
+int CourseManager::findCourse(const std::string& courseCode) const {
+    std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+    int index;
+    {
+        std::unique_lock<std::mutex> indexLock = lockCodeIndex();
+        auto found = codeIndex.find(courseCode);
+        index = found != codeIndex.end() ? found->second.index : -1;
+    }
+    if (index < 0 || mappedSnapshot) {
+        return index;
+    }
+
+    // a code changed through getCourse() without markDirty leaves the index
+    // behind; the hit is checked so that never returns the wrong course
+    {
+        std::shared_lock<std::shared_mutex> courseLock(*courseLocks[index]);
+        if (courses[index].getCourseCode() == courseCode) {
+            return index;
+        }
+    }
+    markCodeIndexStale();
+    std::unique_lock<std::mutex> indexLock = lockCodeIndex();
+    auto found = codeIndex.find(courseCode);
+    return found != codeIndex.end() ? found->second.index : -1;
+}
+
+int CourseManager::countCoursesWithCode(const std::string& courseCode) const {
+    std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+    std::unique_lock<std::mutex> indexLock = lockCodeIndex();
+    auto found = codeIndex.find(courseCode);
+    return found != codeIndex.end() ? found->second.count : 0;
+}
+
+std::vector<std::string> CourseManager::getDuplicateCourseCodes() const {
+    std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+    std::unique_lock<std::mutex> indexLock = lockCodeIndex();
+    std::vector<std::string> duplicates;
+    for (const auto& entry : codeIndex) {
+        if (entry.second.count > 1) {
+            duplicates.push_back(entry.first);
+        }
+    }
+    std::sort(duplicates.begin(), duplicates.end());
+    return duplicates;
+}
+
+// codeIndexMutex, returned locked with the index current; caller holds coursesMutex
+std::unique_lock<std::mutex> CourseManager::lockCodeIndex() const {
+    std::unique_lock<std::mutex> indexLock(codeIndexMutex);
+    if (!codeIndexStale) {
+        return indexLock;
+    }
+
+    // a rebuild reads every code, so it first waits out edits in flight
+    indexLock.unlock();
+    std::vector<std::shared_lock<std::shared_mutex>> locks = lockAllCourses();
+    indexLock.lock();
+    if (codeIndexStale) {
+        codeIndex.clear();
+        int courseCount = mappedSnapshot ? mappedSnapshot->getCourseCount() : static_cast<int>(courses.size());
+        codeIndex.reserve(courseCount);
+        for (int i = 0; i < courseCount; i++) {
+            std::string courseCode = mappedSnapshot ? std::string(mappedSnapshot->getCourse(i).getCourseCode())
+                                                    : courses[i].getCourseCode();
+            auto inserted = codeIndex.emplace(std::move(courseCode), CodeIndexEntry{i, 1});
+            if (!inserted.second) {
+                inserted.first->second.count++;
+            }
+        }
+        codeIndexStale = false;
+    }
+    return indexLock;
+}
+
+// keep the index in step with an applied edit; a stale index is left for the rebuild
+void CourseManager::indexCourseCode(const std::string& courseCode, int index) {
+    std::lock_guard<std::mutex> indexLock(codeIndexMutex);
+    if (codeIndexStale) {
+        return;
+    }
+    auto inserted = codeIndex.emplace(courseCode, CodeIndexEntry{index, 1});
+    if (!inserted.second) {
+        inserted.first->second.index = std::min(inserted.first->second.index, index);
+        inserted.first->second.count++;
+    }
+}
+
+void CourseManager::unindexCourseCode(const std::string& courseCode, int index) {
+    std::lock_guard<std::mutex> indexLock(codeIndexMutex);
+    if (codeIndexStale) {
+        return;
+    }
+    auto found = codeIndex.find(courseCode);
+    if (found == codeIndex.end()) {
+        return;
+    }
+    if (found->second.count == 1) {
+        codeIndex.erase(found);
+    } else if (found->second.index == index) {
+        codeIndexStale = true; // the next lowest index isn't known without a scan
+    } else {
+        found->second.count--;
+    }
+}
+
+void CourseManager::markCodeIndexStale() const {
+    std::lock_guard<std::mutex> indexLock(codeIndexMutex);
+    codeIndexStale = true;
+}
+
+// thread-safe reads
+bool CourseManager::getCourseCopy(int index, Course& course) const {
+    std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+    if (mappedSnapshot) {
+        // the mapping is immutable, it only goes away under the exclusive lock
+        if (index < 0 || index >= mappedSnapshot->getCourseCount()) {
+            return false;
+        }
+        course = mappedSnapshot->getCourse(index).toCourse();
+        return true;
+    }
+
+    if (index < 0 || index >= static_cast<int>(courses.size())) {
+        return false;
+    }
+    std::shared_lock<std::shared_mutex> courseLock(*courseLocks[index]);
+    course = courses[index];
+    return true;
+}
+
+bool CourseManager::getCourseSummary(int index, bool careForComplete, GradeSummary& summary) const {
+    std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+    if (mappedSnapshot) {
+        if (index < 0 || index >= mappedSnapshot->getCourseCount()) {
+            return false;
+        }
+        summary = mappedSnapshot->getCourse(index).calculateSummary(careForComplete);
+        return true;
+    }
+
+    if (index < 0 || index >= static_cast<int>(courses.size())) {
+        return false;
+    }
+    std::shared_lock<std::shared_mutex> courseLock(*courseLocks[index]);
+    summary = courses[index].calculateSummary(careForComplete);
+    return true;
+}
+
+std::vector<Course> CourseManager::getCoursesSnapshot(uint64_t& revision) const {
+    materialise();
+    std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+    std::vector<std::shared_lock<std::shared_mutex>> locks = lockAllCourses();
+
+    // no writer holds a course lock now, so every journaled edit up to
+    // lastSequence is applied and none after it
+    std::lock_guard<std::mutex> journalLock(journalMutex);
+    revision = lastSequence;
+    return courses;
+}
+
+std::vector<CourseEvaluation> CourseManager::evaluateAll(double goal, unsigned threadCount) const {
+    std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+
+    int courseCount = mappedSnapshot ? mappedSnapshot->getCourseCount() : static_cast<int>(courses.size());
+    std::vector<CourseEvaluation> results(courseCount);
+
+    // each thread writes only the result slots of the courses it claimed
+    auto evaluate = [this, goal, &results](int index) {
+        CourseEvaluation& result = results[index];
+        if (mappedSnapshot) {
+            // read straight from the mapping, no Course is built
+            BucketSums totals;
+            mappedSnapshot->getCourse(index).sumBuckets(totals);
+            result.summary = Course::calculateSummary(totals, true);
+            result.requiredGrade = Course::calculateRequiredUniformGrade(totals, goal, result.isGoalAchievable);
+        } else {
+            // per-course locks taken by the workers, so locking scales with them too
+            std::shared_lock<std::shared_mutex> courseLock(*courseLocks[index]);
+            result.summary = courses[index].calculateSummary(true);
+            result.requiredGrade = courses[index].calculateRequiredUniformGrade(goal, result.isGoalAchievable);
+        }
+    };
+
+    parallelFor(courseCount, 64, threadCount, evaluate);
+    return results;
+}
+
+RequiredGradeMatrix CourseManager::calculateRequiredGradeMatrix(const std::vector<double>& goals,
+                                                               unsigned threadCount) const {
+    std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+
+    int courseCount = mappedSnapshot ? mappedSnapshot->getCourseCount() : static_cast<int>(courses.size());
+    RequiredGradeMatrix matrix(goals, courseCount);
+
+    // each worker writes only the rows of the courses it claimed
+    parallelFor(courseCount, 64, threadCount, [this, &matrix](int index) {
+        if (mappedSnapshot) {
+            mappedSnapshot->getCourse(index).calculateRequiredUniformGrades(matrix.goals, matrix.getRow(index),
+                                                                            matrix.getAchievableRow(index));
+        } else {
+            std::shared_lock<std::shared_mutex> courseLock(*courseLocks[index]);
+            courses[index].calculateRequiredUniformGrades(matrix.goals, matrix.getRow(index),
+                                                          matrix.getAchievableRow(index));
+        }
+    });
+    return matrix;
+}
+
+// shared lock on every course, in index order; caller holds coursesMutex
+std::vector<std::shared_lock<std::shared_mutex>> CourseManager::lockAllCourses() const {
+    std::vector<std::shared_lock<std::shared_mutex>> locks;
+    locks.reserve(courseLocks.size());
+    for (const std::unique_ptr<std::shared_mutex>& courseLock : courseLocks) {
+        locks.emplace_back(*courseLock);
+    }
+    return locks;
+}
+
+// one lock per course; only called with coursesMutex held exclusively, when no
+// course lock can be held, so which lock pairs with which course doesn't matter
+void CourseManager::resizeCourseLocks() const {
+    while (courseLocks.size() < courses.size()) {
+        courseLocks.push_back(std::unique_ptr<std::shared_mutex>(new std::shared_mutex()));
+    }
+    courseLocks.resize(courses.size());
+}
+
 const std::vector<Course>& CourseManager::getAllCourses() const {
+    materialise();
     return courses;
 }
 
+bool CourseManager::isMapped() const {
+    std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+    return mappedSnapshot != nullptr;
+}
+
+MappedCourseView CourseManager::getMappedCourse(int index) const {
+    std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+    return mappedSnapshot->getCourse(index);
+}
+
+// journaled edits
+void CourseManager::setCourseCode(int courseIndex, const std::string& newCourseCode) {
+    JournalRecord record;
+    record.type = JournalRecord::Type::SetCourseCode;
+    record.courseIndex = courseIndex;
+    record.text = newCourseCode;
+    recordEdit(std::move(record));
+}
+
+void CourseManager::setIsA5050Course(int courseIndex, bool newIsA5050Course) {
+    JournalRecord record;
+    record.type = JournalRecord::Type::SetIsA5050Course;
+    record.courseIndex = courseIndex;
+    record.flag = newIsA5050Course;
+    recordEdit(std::move(record));
+}
+
+void CourseManager::setCourseCredits(int courseIndex, double newCredits) {
+    JournalRecord record;
+    record.type = JournalRecord::Type::SetCourseCredits;
+    record.courseIndex = courseIndex;
+    record.number = newCredits;
+    recordEdit(std::move(record));
+}
+
+void CourseManager::setCourseTerm(int courseIndex, const std::string& newTerm) {
+    JournalRecord record;
+    record.type = JournalRecord::Type::SetCourseTerm;
+    record.courseIndex = courseIndex;
+    record.text = newTerm;
+    recordEdit(std::move(record));
+}
+
+void CourseManager::addAssessment(int courseIndex, const Assessment& assessment) {
+    JournalRecord record;
+    record.type = JournalRecord::Type::AddAssessment;
+    record.courseIndex = courseIndex;
+    record.assessments.push_back(assessment);
+    recordEdit(std::move(record));
+}
+
+void CourseManager::removeAssessment(int courseIndex, int assessmentIndex) {
+    JournalRecord record;
+    record.type = JournalRecord::Type::RemoveAssessment;
+    record.courseIndex = courseIndex;
+    record.assessmentIndex = assessmentIndex;
+    recordEdit(std::move(record));
+}
+
+void CourseManager::updateAssessmentName(int courseIndex, int assessmentIndex, const std::string& newName) {
+    JournalRecord record;
+    record.type = JournalRecord::Type::UpdateAssessmentName;
+    record.courseIndex = courseIndex;
+    record.assessmentIndex = assessmentIndex;
+    record.text = newName;
+    recordEdit(std::move(record));
+}
+
+void CourseManager::updateAssessmentWeight(int courseIndex, int assessmentIndex, double newWeight) {
+    JournalRecord record;
+    record.type = JournalRecord::Type::UpdateAssessmentWeight;
+    record.courseIndex = courseIndex;
+    record.assessmentIndex = assessmentIndex;
+    record.number = newWeight;
+    recordEdit(std::move(record));
+}
+
+void CourseManager::updateAssessmentType(int courseIndex, int assessmentIndex, bool isTheory) {
+    JournalRecord record;
+    record.type = JournalRecord::Type::UpdateAssessmentType;
+    record.courseIndex = courseIndex;
+    record.assessmentIndex = assessmentIndex;
+    record.flag = isTheory;
+    recordEdit(std::move(record));
+}
+
+void CourseManager::updateAssessmentCompletionStatus(int courseIndex, int assessmentIndex, bool isComplete) {
+    JournalRecord record;
+    record.type = JournalRecord::Type::UpdateAssessmentCompletionStatus;
+    record.courseIndex = courseIndex;
+    record.assessmentIndex = assessmentIndex;
+    record.flag = isComplete;
+    recordEdit(std::move(record));
+}
+
+void CourseManager::updateAssessmentGrade(int courseIndex, int assessmentIndex, double newGrade) {
+    JournalRecord record;
+    record.type = JournalRecord::Type::UpdateAssessmentGrade;
+    record.courseIndex = courseIndex;
+    record.assessmentIndex = assessmentIndex;
+    record.number = newGrade;
+    recordEdit(std::move(record));
+}
+
+// apply one edit to the in-memory courses; false (and no change) if it doesn't fit
+bool CourseManager::applyRecord(const JournalRecord& record) {
+    using Type = JournalRecord::Type;
+
+    if (record.type == Type::AddCourse) {
+        courses.emplace_back(record.text, record.assessments, record.flag);
+        courses.back().setCredits(record.number);
+        courses.back().setTerm(record.term);
+        indexCourseCode(record.text, static_cast<int>(courses.size()) - 1);
+        return true;
+    }
+
+    if (record.courseIndex < 0 || record.courseIndex >= static_cast<int>(courses.size())) {
+        return false;
+    }
+    Course& course = courses[record.courseIndex];
+
+    bool touchesAssessment = record.type != Type::RemoveCourse && record.type != Type::SetCourseCode &&
+                             record.type != Type::SetIsA5050Course && record.type != Type::SetCourseCredits &&
+                             record.type != Type::SetCourseTerm && record.type != Type::AddAssessment;
+    if (touchesAssessment &&
+        (record.assessmentIndex < 0 || record.assessmentIndex >= course.getAssessmentCount())) {
+        return false;
+    }
+
+    switch (record.type) {
+        case Type::RemoveCourse:
+            courses.erase(courses.begin() + record.courseIndex);
+            markCodeIndexStale(); // every later index shifts down
+            break;
+        case Type::SetCourseCode:
+            unindexCourseCode(course.getCourseCode(), record.courseIndex);
+            course.setCourseCode(record.text);
+            indexCourseCode(record.text, record.courseIndex);
+            break;
+        case Type::SetIsA5050Course:
+            course.setIsA5050Course(record.flag);
+            break;
+        case Type::SetCourseCredits:
+            course.setCredits(record.number);
+            break;
+        case Type::SetCourseTerm:
+            course.setTerm(record.text);
+            break;
+        case Type::AddAssessment:
+            if (record.assessments.empty()) {
+                return false;
+            }
+            course.addAssessment(record.assessments[0]);
+            break;
+        case Type::RemoveAssessment:
+            course.removeAssessment(record.assessmentIndex);
+            break;
+        case Type::UpdateAssessmentName:
+            course.updateAssessmentName(record.assessmentIndex, record.text);
+            break;
+        case Type::UpdateAssessmentWeight:
+            course.updateAssessmentWeight(record.assessmentIndex, record.number);
+            break;
+        case Type::UpdateAssessmentType:
+            course.updateAssessmentType(record.assessmentIndex, record.flag);
+            break;
+        case Type::UpdateAssessmentCompletionStatus:
+            course.updateAssessmentCompletionStatus(record.assessmentIndex, record.flag);
+            break;
+        case Type::UpdateAssessmentGrade:
+            course.updateAssessmentGrade(record.assessmentIndex, record.number);
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+bool CourseManager::recordEdit(JournalRecord record) {
+    materialise();
+
+    // the journal replays onto the last full save, so that save has to be current
+    bool needsFullSave;
+    {
+        std::lock_guard<std::mutex> journalLock(journalMutex);
+        needsFullSave = unjournaledChanges;
+    }
+    if (needsFullSave && !flush()) {
+        return false;
+    }
+
+    bool isListEdit = record.type == JournalRecord::Type::AddCourse ||
+                      record.type == JournalRecord::Type::RemoveCourse;
+    if (isListEdit) {
+        std::unique_lock<std::shared_mutex> listLock(coursesMutex);
+        if (!applyRecord(record)) {
+            return false;
+        }
+        resizeCourseLocks();
+        needsFullSave = appendToJournal(record);
+        if (record.type == JournalRecord::Type::AddCourse) {
+            int added = static_cast<int>(courses.size()) - 1;
+            notifyListeners({CourseChange::Type::Added, added, record.sequence, &courses[added]});
+        } else {
+            notifyListeners({CourseChange::Type::Removed, record.courseIndex, record.sequence, nullptr});
+        }
+    } else {
+        // other courses stay readable and editable meanwhile
+        std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+        if (record.courseIndex < 0 || record.courseIndex >= static_cast<int>(courseLocks.size())) {
+            return false;
+        }
+        std::unique_lock<std::shared_mutex> courseLock(*courseLocks[record.courseIndex]);
+        if (!applyRecord(record)) {
+            return false;
+        }
+        needsFullSave = appendToJournal(record);
+        notifyListeners({CourseChange::Type::Edited, record.courseIndex, record.sequence,
+                         &courses[record.courseIndex]});
+    }
+
+    if (needsFullSave) {
+        return flush(); // no journal to lean on, or time to compact
+    }
+    return true;
+}
+
+// sequence and append an applied edit; the caller still holds its course lock,
+// so per-course journal order matches the order edits were applied
+bool CourseManager::appendToJournal(JournalRecord& record) {
+    std::lock_guard<std::mutex> journalLock(journalMutex);
+    record.sequence = ++lastSequence;
+    dirty = true;
+    recordsSinceCompaction++;
+    return !journal.append(record) || recordsSinceCompaction >= compactionThreshold;
+}
+
+// change notification
+int CourseManager::addChangeListener(std::function<void(const CourseChange&)> listener) {
+    std::unique_lock<std::shared_mutex> lock(listenersMutex);
+    int id = nextListenerId++;
+    listeners.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void CourseManager::removeChangeListener(int id) {
+    std::unique_lock<std::shared_mutex> lock(listenersMutex);
+    listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+                                   [id](const auto& entry) { return entry.first == id; }),
+                    listeners.end());
+}
+
+// shared, so edits to different courses notify in parallel
+void CourseManager::notifyListeners(const CourseChange& change) const {
+    std::shared_lock<std::shared_mutex> lock(listenersMutex);
+    for (const auto& entry : listeners) {
+        entry.second(change);
+    }
+}
+
+void CourseManager::notifyReloaded() const {
+    notifyListeners({CourseChange::Type::Reloaded, -1, 0, nullptr});
+}
+
+void CourseManager::materialise() const {
+    {
+        std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+        if (!mappedSnapshot) {
+            return;
+        }
+    }
+    std::unique_lock<std::shared_mutex> listLock(coursesMutex);
+    materialiseLocked();
+}
+
+// copy every mapped record into owning Course objects and drop the mapping
+void CourseManager::materialiseLocked() const {
+    if (!mappedSnapshot) {
+        return;
+    }
+
+    std::vector<Course> loaded;
+    loaded.reserve(mappedSnapshot->getCourseCount());
+    for (int i = 0; i < mappedSnapshot->getCourseCount(); i++) {
+        loaded.push_back(mappedSnapshot->getCourse(i).toCourse());
+    }
+
+    courses = std::move(loaded);
+    mappedSnapshot.reset();
+    resizeCourseLocks();
+}
+
 //file management
+std::string CourseManager::getSnapshotFilePath() const {
+    return std::filesystem::path(dataFilePath).replace_extension(".snap").string();
+}
+
+std::string CourseManager::getJournalFilePath() const {
+    return std::filesystem::path(dataFilePath).replace_extension(".journal").string();
+}
+
+// a hand-edited JSON file wins over a stale snapshot
+bool CourseManager::isSnapshotCurrent() const {
+    std::error_code error;
+    std::string snapshotPath = getSnapshotFilePath();
+
+    if (!std::filesystem::exists(snapshotPath, error)) {
+        return false;
+    }
+
+    auto snapshotTime = std::filesystem::last_write_time(snapshotPath, error);
+    return !(std::filesystem::exists(dataFilePath, error) &&
+             std::filesystem::last_write_time(dataFilePath, error) > snapshotTime);
+}
+
 bool CourseManager::loadFromFile() {
+    std::lock_guard<std::recursive_mutex> lock(persistMutex);
+    std::unique_lock<std::shared_mutex> listLock(coursesMutex);
+    std::lock_guard<std::mutex> journalLock(journalMutex);
+    mappedSnapshot.reset();
+    markCodeIndexStale();
+
+    bool loaded = false;
+    uint64_t revision = 0;
+    if (isSnapshotCurrent()) {
+        if (readOnly) {
+            std::unique_ptr<MappedSnapshot> mapping(new MappedSnapshot());
+            if (mapping->open(getSnapshotFilePath())) {
+                courses.clear();
+                mappedSnapshot = std::move(mapping);
+                revision = mappedSnapshot->getRevision();
+                loaded = true;
+            }
+        }
+        if (!loaded) {
+            loaded = CourseSnapshot::load(getSnapshotFilePath(), courses, revision);
+        }
+    }
+    if (!loaded && !loadFromJson(revision)) {
+        lastLoadSucceeded = false;
+        resizeCourseLocks();
+        notifyReloaded();
+        return false;
+    }
+    lastLoadSucceeded = true;
+
+    // replay edits made since that save; the mapping only has to go if there are any
+    int replayed = 0;
+    lastSequence = journal.replay(revision, !readOnly, [this, &replayed](const JournalRecord& record) {
+        materialiseLocked();
+        applyRecord(record);
+        replayed++;
+    });
+    resizeCourseLocks();
+
+    dirty = replayed > 0;
+    recordsSinceCompaction = replayed;
+    unjournaledChanges = false;
+    notifyReloaded();
+    return true;
+}
+
+bool CourseManager::isLoaded() const {
+    std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+    return lastLoadSucceeded;
+}
+
+bool CourseManager::loadFromSnapshot() {
+    std::lock_guard<std::recursive_mutex> lock(persistMutex);
+    std::unique_lock<std::shared_mutex> listLock(coursesMutex);
+    std::lock_guard<std::mutex> journalLock(journalMutex);
+    mappedSnapshot.reset();
+    markCodeIndexStale();
+    bool loaded = CourseSnapshot::load(getSnapshotFilePath(), courses, lastSequence);
+    resizeCourseLocks();
+    notifyReloaded();
+    return loaded;
+}
+
+bool CourseManager::saveToSnapshot() const {
+    std::lock_guard<std::recursive_mutex> lock(persistMutex);
+    materialise();
+    std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+    std::vector<std::shared_lock<std::shared_mutex>> locks = lockAllCourses();
+
+    uint64_t revision;
+    {
+        std::lock_guard<std::mutex> journalLock(journalMutex);
+        revision = lastSequence;
+    }
+    return writeSnapshot(revision);
+}
+
+// caller holds every course lock
+bool CourseManager::writeSnapshot(uint64_t revision) const {
+    return CourseSnapshot::save(getSnapshotFilePath(), courses, revision);
+}
+
+bool CourseManager::loadFromJson(uint64_t& revision) {
     try {
         std::ifstream file(dataFilePath);
         if (!file.is_open()) {
+            // a read-only manager starts empty and leaves the disk alone
+            if (readOnly) {
+                courses.clear();
+                revision = 0;
+                return true;
+            }
+
             // File doesn't exist, create an empty one
             std::ofstream newFile(dataFilePath);
             if (!newFile.is_open()) {
@@ -52,32 +712,12 @@ bool CourseManager::loadFromFile() {
             newFile.close();
             
             // Courses vector is already empty by default
+            revision = 0;
             return true;
         }
         
-        json jsonData;
-        file >> jsonData;
-        
-        courses.clear();
-        for (const auto& courseJson : jsonData["courses"]) {
-            std::string courseCode = courseJson["courseCode"];
-            bool isA5050Course = courseJson["isA5050Course"];
-            
-            std::vector<Assessment> assessments;
-            for (const auto& assessmentJson : courseJson["assessments"]) {
-                std::string name = assessmentJson["name"];
-                double weight = assessmentJson["weight"];
-                double grade = assessmentJson["grade"];
-                bool isTheory = assessmentJson["isTheory"];
-                bool isComplete = assessmentJson["isComplete"];
-                
-                Assessment assessment(name, weight, grade, isTheory, isComplete);
-                assessments.push_back(assessment);
-            }
-            
-            Course course(courseCode, assessments, isA5050Course);
-            courses.push_back(course);
-        }
+        // stream straight into Course objects, no JSON DOM in between
+        CourseJsonReader::read(file, courses, revision);
         
         return true;
     } catch (const std::exception& e) {
@@ -86,18 +726,49 @@ bool CourseManager::loadFromFile() {
     }
 }
 
+// Full save against a consistent snapshot: readers carry on, writers wait until
+// both files are written and the journal they fold in is emptied.
 bool CourseManager::saveToFile() const {
+    std::lock_guard<std::recursive_mutex> lock(persistMutex);
+    materialise();
+    std::shared_lock<std::shared_mutex> listLock(coursesMutex);
+    std::vector<std::shared_lock<std::shared_mutex>> locks = lockAllCourses();
+    std::lock_guard<std::mutex> journalLock(journalMutex);
+
+    if (!writeJson(lastSequence) || !writeSnapshot(lastSequence)) {
+        return false;
+    }
+
+    // both files now carry every journaled edit
+    journal.reset();
+    recordsSinceCompaction = 0;
+    unjournaledChanges = false;
+    dirty = false;
+    return true;
+}
+
+// caller holds every course lock
+bool CourseManager::writeJson(uint64_t revision) const {
     try {
-        json jsonData;
-        jsonData["courses"] = json::array();
-        
-        for (const Course& course : courses) {
+        // write beside the data file and rename over it, so a crash mid-write
+        // leaves the previous file intact instead of a truncated one; both are
+        // synced, so a power loss can't leave the renamed file empty either
+        std::string tempPath = dataFilePath + ".tmp";
+        std::ofstream file(tempPath);
+
+        // One course at a time rather than one DOM for the whole file, so memory
+        // stays flat at any size. The text matches dump(4) of the full document.
+        file << "{\n    \"courses\": [";
+        for (size_t i = 0; i < courses.size(); i++) {
+            const Course& course = courses[i];
             json courseJson;
             courseJson["courseCode"] = course.getCourseCode();
             courseJson["isA5050Course"] = course.getIsA5050Course();
+            courseJson["credits"] = course.getCredits();
+            courseJson["term"] = course.getTerm();
             
             courseJson["assessments"] = json::array();
-            for (const Assessment& assessment : course.getAllAssessments()) {
+            for (const AssessmentView& assessment : course.getAssessments()) {
                 json assessmentJson;
                 assessmentJson["name"] = assessment.getName();
                 assessmentJson["weight"] = assessment.getWeight();
@@ -107,15 +778,112 @@ bool CourseManager::saveToFile() const {
                 
                 courseJson["assessments"].push_back(assessmentJson);
             }
-            
-            jsonData["courses"].push_back(courseJson);
+
+            // 4 spaces indentation for pretty printing, nested two levels deep
+            std::string text = courseJson.dump(4);
+            file << (i == 0 ? "\n        " : ",\n        ");
+            size_t lineStart = 0;
+            for (size_t newline = text.find('\n'); newline != std::string::npos; newline = text.find('\n', lineStart)) {
+                file.write(text.data() + lineStart, newline + 1 - lineStart);
+                file << "        ";
+                lineStart = newline + 1;
+            }
+            file.write(text.data() + lineStart, text.size() - lineStart);
+        }
+        file << (courses.empty() ? "],\n" : "\n    ],\n");
+        file << "    \"revision\": " << revision << "\n}";
+        file.close();
+        if (!file.good() || !DurableFile::sync(tempPath)) {
+            std::cerr << "Error saving courses: could not write " << tempPath << std::endl;
+            return false;
+        }
+        if (!DurableFile::replace(tempPath, dataFilePath)) {
+            std::cerr << "Error saving courses: could not replace " << dataFilePath << std::endl;
+            return false;
         }
-        
-        std::ofstream file(dataFilePath);
-        file << jsonData.dump(4); // 4 spaces indentation for pretty printing
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Error saving courses: " << e.what() << std::endl;
         return false;
     }
-}
\ No newline at end of file
+}
+// batched persistence
+void CourseManager::setAutoSave(bool enabled) {
+    std::lock_guard<std::recursive_mutex> lock(persistMutex);
+    autoSave = enabled;
+    if (autoSave) {
+        flush();
+    }
+}
+
+void CourseManager::markDirty() {
+    std::lock_guard<std::recursive_mutex> lock(persistMutex);
+    {
+        std::lock_guard<std::mutex> journalLock(journalMutex);
+        dirty = true;
+        unjournaledChanges = true;
+    }
+    markCodeIndexStale(); // the edit may have changed a course code
+    notifyReloaded();     // and listeners can't tell which course it touched
+    if (autoSave) {
+        saveToFile();
+    }
+}
+
+bool CourseManager::isDirty() const {
+    std::lock_guard<std::mutex> journalLock(journalMutex);
+    return dirty;
+}
+
+bool CourseManager::flush() {
+    std::lock_guard<std::recursive_mutex> lock(persistMutex);
+    if (!isDirty()) {
+        return true;
+    }
+    return saveToFile();
+}
+
+void CourseManager::startFlushTimer(std::chrono::milliseconds interval) {
+    stopFlushTimer();
+    stopFlushThread = false;
+    {
+        // each tick's full save syncs everything, so appends needn't one by one
+        std::lock_guard<std::mutex> journalLock(journalMutex);
+        journal.setSyncOnAppend(false);
+    }
+
+    flushThread = std::thread([this, interval]() {
+        std::unique_lock<std::recursive_mutex> lock(persistMutex);
+        while (!stopFlushThread) {
+            flushSignal.wait_for(lock, interval, [this]() { return stopFlushThread; });
+            if (!stopFlushThread) {
+                flush();
+            }
+        }
+    });
+}
+
+void CourseManager::stopFlushTimer() {
+    if (!flushThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::recursive_mutex> lock(persistMutex);
+        stopFlushThread = true;
+    }
+    flushSignal.notify_all();
+    flushThread.join();
+
+    std::lock_guard<std::mutex> journalLock(journalMutex);
+    journal.setSyncOnAppend(true);
+    journal.sync(); // records since the last tick
+}
+
+std::unique_lock<std::recursive_mutex> CourseManager::lockForEdit() const {
+    return std::unique_lock<std::recursive_mutex>(persistMutex);
+}
+
+void CourseManager::setCompactionThreshold(int records) {
+    std::lock_guard<std::mutex> journalLock(journalMutex);
+    compactionThreshold = records > 0 ? records : 1;
+}
@@ -1,30 +1,205 @@
 #ifndef COURSE_MANAGER_H
 #define COURSE_MANAGER_H
 
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include "Course.h"
+#include "EditJournal.h"
+#include "MappedSnapshot.h"
+
+// Result of evaluateAll for one course, at the same index as the course.
+struct CourseEvaluation {
+    GradeSummary summary;        // calculateSummary(true)
+    double requiredGrade;        // calculateRequiredUniformGrade(goal, ...)
+    bool isGoalAchievable;
+};
+
+// What a change listener hears after each edit. course points at the edited or
+// added course and is only valid during the call; it is null for Removed and
+// Reloaded. Reloaded means any course may have changed (a load, or a direct
+// edit reported through markDirty) and carries no index.
+struct CourseChange {
+    enum class Type {
+        Edited,
+        Added,
+        Removed,
+        Reloaded
+    };
+    Type type;
+    int courseIndex;
+    uint64_t sequence; // journal sequence of the edit, 0 for Reloaded
+    const Course* course;
+};
 
 class CourseManager {
 private:
-    std::vector<Course> courses;
+    // In read-only mode the snapshot stays mapped and courses is empty until the
+    // first call that needs owning Course objects; both are mutable so const
+    // accessors like getAllCourses can materialise on demand.
+    mutable std::vector<Course> courses;
+    mutable std::unique_ptr<MappedSnapshot> mappedSnapshot;
+
+    // Concurrency: coursesMutex guards the list itself (shared for anything that
+    // indexes it, exclusive to add, remove, load or materialise) and courseLocks
+    // holds one lock per course for its contents. Lock order is persistMutex,
+    // coursesMutex, a course lock, then journalMutex.
+    mutable std::shared_mutex coursesMutex;
+    mutable std::vector<std::unique_ptr<std::shared_mutex>> courseLocks;
+
+    // Course code -> lowest index using it and how many courses do. Journaled
+    // edits keep it current; removals and direct edits (markDirty) only mark it
+    // stale and the next lookup rebuilds it. codeIndexMutex guards both and is
+    // always the innermost lock.
+    struct CodeIndexEntry {
+        int index;
+        int count;
+    };
+    mutable std::unordered_map<std::string, CodeIndexEntry> codeIndex;
+    mutable bool codeIndexStale = true;
+    mutable std::mutex codeIndexMutex;
     std::string dataFilePath;
+    bool readOnly;
+    bool lastLoadSucceeded = false; // guarded by coursesMutex
+
+    // Write coalescing: with autoSave off, edits only mark the data dirty and one
+    // flush (explicit, from the timer, or on destruction) writes the files.
+    bool autoSave = true;
+    mutable bool dirty = false;
+
+    // Write-ahead journal: edits made through the manager are appended as records
+    // and replayed on load; a full save folds them in and empties the journal.
+    // unjournaledChanges marks edits made directly on a Course (see markDirty),
+    // which have to be saved in full before the journal can describe anything.
+    // journalMutex guards the journal file and the counters and flags below it.
+    mutable std::mutex journalMutex;
+    mutable EditJournal journal;
+    mutable uint64_t lastSequence = 0;
+    mutable int recordsSinceCompaction = 0;
+    mutable bool unjournaledChanges = false;
+    int compactionThreshold = 1000;
+    mutable std::recursive_mutex persistMutex;
+    std::thread flushThread;
+    std::condition_variable_any flushSignal;
+    bool stopFlushThread = false;
+
+    // Change listeners run on the editing thread while it still holds the lock
+    // of what it changed, so per course they hear edits in the order they were
+    // applied. listenersMutex comes after every lock above except codeIndexMutex.
+    mutable std::shared_mutex listenersMutex;
+    std::vector<std::pair<int, std::function<void(const CourseChange&)>>> listeners;
+    int nextListenerId = 0;
+
+    std::string getSnapshotFilePath() const;
+    std::string getJournalFilePath() const;
+    bool isSnapshotCurrent() const;
+    bool loadFromJson(uint64_t& revision);
+    void materialise() const;
+    void materialiseLocked() const; // caller holds coursesMutex exclusively
+    void resizeCourseLocks() const;
+    std::vector<std::shared_lock<std::shared_mutex>> lockAllCourses() const;
+    std::unique_lock<std::mutex> lockCodeIndex() const;
+    void indexCourseCode(const std::string& courseCode, int index);
+    void unindexCourseCode(const std::string& courseCode, int index);
+    void markCodeIndexStale() const;
+    bool writeJson(uint64_t revision) const;
+    bool writeSnapshot(uint64_t revision) const;
+
+    bool applyRecord(const JournalRecord& record);
+    bool recordEdit(JournalRecord record);
+    bool appendToJournal(JournalRecord& record); // true when a full save is due
+    void notifyListeners(const CourseChange& change) const;
+    void notifyReloaded() const;
 
 public:
     //constructor
-    CourseManager(const std::string& filePath = "courses.json");
+    // readOnly maps an up-to-date snapshot instead of loading it, see getMappedCourse
+    CourseManager(const std::string& filePath = "courses.json", bool readOnly = false);
+    ~CourseManager(); // flushes pending edits unless readOnly
+    CourseManager(const CourseManager&) = delete;
+    CourseManager& operator=(const CourseManager&) = delete;
 
     //course management
     void addCourse(const Course& course);
     void removeCourse(int index);
-    Course& getCourse(int index);
+    Course& getCourse(int index); // single-threaded callers only, see getCourseCopy
     int getCourseCount() const;
 
+    //lookup by course code through a hash index, thread-safe
+    // findCourse gives the lowest index with that code, -1 if there is none
+    int findCourse(const std::string& courseCode) const;
+    int countCoursesWithCode(const std::string& courseCode) const;
+    std::vector<std::string> getDuplicateCourseCodes() const;
+
+    //thread-safe reads, usable while other threads make journaled edits
+    bool getCourseCopy(int index, Course& course) const;
+    bool getCourseSummary(int index, bool careForComplete, GradeSummary& summary) const;
+    // every course as of one journal revision, with no edit half applied
+    std::vector<Course> getCoursesSnapshot(uint64_t& revision) const;
+
+    //bulk evaluation of every course against one goal, spread over threadCount
+    // threads (0 = one per core); each course is read under its own shared lock
+    std::vector<CourseEvaluation> evaluateAll(double goal, unsigned threadCount = 0) const;
+    // required uniform grade of every course for every goal, one row per course
+    RequiredGradeMatrix calculateRequiredGradeMatrix(const std::vector<double>& goals, unsigned threadCount = 0) const;
+
+    //journaled edits, each costs one appended record instead of a full save
+    // Edits to different courses run in parallel; adding or removing a course
+    // briefly excludes everything else.
+    void setCourseCode(int courseIndex, const std::string& newCourseCode);
+    void setIsA5050Course(int courseIndex, bool newIsA5050Course);
+    void setCourseCredits(int courseIndex, double newCredits);
+    void setCourseTerm(int courseIndex, const std::string& newTerm);
+    void addAssessment(int courseIndex, const Assessment& assessment);
+    void removeAssessment(int courseIndex, int assessmentIndex);
+    void updateAssessmentName(int courseIndex, int assessmentIndex, const std::string& newName);
+    void updateAssessmentWeight(int courseIndex, int assessmentIndex, double newWeight);
+    void updateAssessmentType(int courseIndex, int assessmentIndex, bool isTheory);
+    void updateAssessmentCompletionStatus(int courseIndex, int assessmentIndex, bool isComplete);
+    void updateAssessmentGrade(int courseIndex, int assessmentIndex, double newGrade);
+
+    //change notification, for derived state kept up to date edit by edit
+    // A listener must be quick and must not call back into the manager: it runs
+    // under the manager's locks. Returns an id for removeChangeListener, which
+    // waits for calls in progress to finish.
+    int addChangeListener(std::function<void(const CourseChange&)> listener);
+    void removeChangeListener(int id);
+
+    //zero-copy access while the snapshot is mapped
+    bool isMapped() const;
+    MappedCourseView getMappedCourse(int index) const;
+
     //file op
+    // loadFromFile prefers the binary snapshot when it is at least as new as the
+    // JSON file, falls back to JSON otherwise, then replays the journal on top.
+    // saveToFile writes both atomically and empties the journal.
     bool loadFromFile();
+    bool isLoaded() const; // false if the last loadFromFile failed, e.g. on a malformed file
     bool saveToFile() const;
+    bool loadFromSnapshot();
+    bool saveToSnapshot() const;
+
+    //batched persistence
+    void setAutoSave(bool enabled); // true (default): every markDirty saves at once
+    void markDirty();               // call after editing a course obtained from getCourse
+    void setCompactionThreshold(int records); // full save after this many journal records
+    bool isDirty() const;
+    bool flush();                   // save if anything changed since the last save
+    // While the timer runs, journaled edits reach the disk once per interval
+    // instead of being synced one by one.
+    void startFlushTimer(std::chrono::milliseconds interval);
+    void stopFlushTimer();
+    // Hold this while editing through getCourse() when the flush timer is running.
+    std::unique_lock<std::recursive_mutex> lockForEdit() const;
 
-    const std::vector<Course>& getAllCourses() const;
+    const std::vector<Course>& getAllCourses() const; // single-threaded callers only
 
 };
 #endif
\ No newline at end of file
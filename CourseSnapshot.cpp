@@ -0,0 +1,329 @@
+#include "CourseSnapshot.h"
+#include "DurableFile.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+
+namespace {
+
+const char snapshotMagic[8] = {'G', 'R', 'D', 'S', 'N', 'A', 'P', '1'};
+const size_t headerSizeV1 = 32;
+const size_t headerSize = 40;
+const size_t courseRecordSizeV2 = 24;
+const size_t courseRecordSizeV3 = 32;
+const size_t assessmentRecordSize = 24;
+
+const uint32_t courseIs5050Flag = 1u << 0;
+const uint32_t assessmentIsTheoryFlag = 1u << 0;
+const uint32_t assessmentIsCompleteFlag = 1u << 1;
+
+// counts, string offsets and string lengths are stored as uint32_t
+const uint64_t maxStoredSize = std::numeric_limits<uint32_t>::max();
+
+template<typename T>
+T readValue(const char* source) {
+    T value;
+    std::memcpy(&value, source, sizeof(T));
+    return value;
+}
+
+template<typename T>
+void appendValue(std::string& buffer, T value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+} // namespace
+
+// Reader
+bool SnapshotReader::open(const char* data, size_t size, std::string& error) {
+    if (size < headerSizeV1 || std::memcmp(data, snapshotMagic, sizeof(snapshotMagic)) != 0) {
+        error = "not a course snapshot";
+        return false;
+    }
+
+    uint32_t fileVersion = readValue<uint32_t>(data + 8);
+    if (fileVersion < 1 || fileVersion > CourseSnapshot::version) {
+        error = "unsupported snapshot version " + std::to_string(fileVersion);
+        return false;
+    }
+
+    size_t fileHeaderSize = fileVersion == 1 ? headerSizeV1 : headerSize;
+    if (size < fileHeaderSize) {
+        error = "truncated header";
+        return false;
+    }
+
+    uint32_t courses = readValue<uint32_t>(data + 12);
+    uint64_t assessments = readValue<uint64_t>(data + 16);
+    uint64_t stringSize = readValue<uint64_t>(data + 24);
+
+    // compare section by section so a corrupt count can't overflow the total
+    size_t recordSize = fileVersion < 3 ? courseRecordSizeV2 : courseRecordSizeV3;
+    uint64_t remaining = size - fileHeaderSize;
+    uint64_t courseBytes = uint64_t(courses) * recordSize;
+    if (courseBytes > remaining) {
+        error = "truncated course records";
+        return false;
+    }
+    remaining -= courseBytes;
+    if (assessments > remaining / assessmentRecordSize) {
+        error = "truncated assessment records";
+        return false;
+    }
+    remaining -= assessments * assessmentRecordSize;
+    if (stringSize != remaining) {
+        error = "string section size mismatch";
+        return false;
+    }
+
+    this->data = data;
+    this->size = size;
+    courseCount = courses;
+    assessmentCount = assessments;
+    stringBytes = stringSize;
+    revision = fileVersion == 1 ? 0 : readValue<uint64_t>(data + 32);
+    courseRecords = data + fileHeaderSize;
+    courseRecordSize = recordSize;
+    assessmentRecords = courseRecords + courseBytes;
+    strings = assessmentRecords + assessments * assessmentRecordSize;
+    return true;
+}
+
+std::string_view SnapshotReader::readString(uint32_t offset) const {
+    if (uint64_t(offset) + sizeof(uint32_t) > stringBytes) {
+        return std::string_view();
+    }
+    uint32_t length = readValue<uint32_t>(strings + offset);
+    if (uint64_t(offset) + sizeof(uint32_t) + length > stringBytes) {
+        return std::string_view();
+    }
+    return std::string_view(strings + offset + sizeof(uint32_t), length);
+}
+
+std::string_view SnapshotReader::getCourseCode(uint32_t course) const {
+    return readString(readValue<uint32_t>(courseRecords + course * courseRecordSize));
+}
+
+bool SnapshotReader::getIsA5050Course(uint32_t course) const {
+    return readValue<uint32_t>(courseRecords + course * courseRecordSize + 4) & courseIs5050Flag;
+}
+
+uint64_t SnapshotReader::getFirstAssessment(uint32_t course) const {
+    uint64_t first = readValue<uint64_t>(courseRecords + course * courseRecordSize + 8);
+    return first < assessmentCount ? first : assessmentCount;
+}
+
+uint32_t SnapshotReader::getAssessmentCount(uint32_t course) const {
+    uint64_t count = readValue<uint32_t>(courseRecords + course * courseRecordSize + 16);
+    uint64_t available = assessmentCount - getFirstAssessment(course);
+    return static_cast<uint32_t>(count < available ? count : available);
+}
+
+std::string_view SnapshotReader::getTerm(uint32_t course) const {
+    if (courseRecordSize < courseRecordSizeV3) {
+        return std::string_view();
+    }
+    return readString(readValue<uint32_t>(courseRecords + course * courseRecordSize + 20));
+}
+
+double SnapshotReader::getCredits(uint32_t course) const {
+    if (courseRecordSize < courseRecordSizeV3) {
+        return Course::defaultCredits;
+    }
+    return readValue<double>(courseRecords + course * courseRecordSize + 24);
+}
+
+std::string_view SnapshotReader::getAssessmentName(uint64_t assessment) const {
+    return readString(readValue<uint32_t>(assessmentRecords + assessment * assessmentRecordSize + 16));
+}
+
+double SnapshotReader::getAssessmentWeight(uint64_t assessment) const {
+    return readValue<double>(assessmentRecords + assessment * assessmentRecordSize);
+}
+
+double SnapshotReader::getAssessmentGrade(uint64_t assessment) const {
+    return readValue<double>(assessmentRecords + assessment * assessmentRecordSize + 8);
+}
+
+bool SnapshotReader::getAssessmentIsTheory(uint64_t assessment) const {
+    return readValue<uint32_t>(assessmentRecords + assessment * assessmentRecordSize + 20) & assessmentIsTheoryFlag;
+}
+
+bool SnapshotReader::getAssessmentIsComplete(uint64_t assessment) const {
+    return readValue<uint32_t>(assessmentRecords + assessment * assessmentRecordSize + 20) & assessmentIsCompleteFlag;
+}
+
+Course SnapshotReader::materialiseCourse(uint32_t course) const {
+    uint64_t first = getFirstAssessment(course);
+    uint32_t count = getAssessmentCount(course);
+
+    std::vector<Assessment> assessments;
+    assessments.reserve(count);
+    for (uint64_t a = first; a < first + count; a++) {
+        assessments.emplace_back(getAssessmentName(a), getAssessmentWeight(a), getAssessmentGrade(a),
+                                 getAssessmentIsTheory(a), getAssessmentIsComplete(a));
+    }
+
+    Course result(std::string(getCourseCode(course)), std::move(assessments), getIsA5050Course(course));
+    result.setCredits(getCredits(course));
+    result.setTerm(std::string(getTerm(course)));
+    return result;
+}
+
+void SnapshotReader::sumCourseBuckets(uint32_t course, BucketSums& sums) const {
+    uint64_t first = getFirstAssessment(course);
+    uint32_t count = getAssessmentCount(course);
+
+    // reused across calls, so a pass over every course allocates only for its largest one
+    thread_local std::vector<double> weights;
+    thread_local std::vector<double> grades;
+    thread_local std::vector<uint64_t> theoryMask;
+    thread_local std::vector<uint64_t> completeMask;
+    weights.resize(count);
+    grades.resize(count);
+    theoryMask.assign((count + 63) / 64, 0);
+    completeMask.assign((count + 63) / 64, 0);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const char* record = assessmentRecords + (first + i) * assessmentRecordSize;
+        weights[i] = readValue<double>(record);
+        grades[i] = readValue<double>(record + 8);
+        uint32_t flags = readValue<uint32_t>(record + 20);
+        theoryMask[i / 64] |= uint64_t((flags & assessmentIsTheoryFlag) != 0) << (i % 64);
+        completeMask[i / 64] |= uint64_t((flags & assessmentIsCompleteFlag) != 0) << (i % 64);
+    }
+    GradeKernels::sumBuckets(weights.data(), grades.data(), theoryMask.data(), completeMask.data(), count, sums);
+}
+
+// File I/O
+bool CourseSnapshot::save(const std::string& filePath, const std::vector<Course>& courses, uint64_t revision) {
+    if (courses.size() > maxStoredSize) {
+        std::cerr << "Error: Could not write snapshot file at " << filePath << ": too many courses" << std::endl;
+        return false;
+    }
+
+    // a string past what a uint32_t offset or length can reach would wrap
+    // silently and read back as another string, so it fails the save instead
+    std::string stringSection;
+    std::unordered_map<std::string, uint32_t> stringOffsets;
+    bool stringsFit = true;
+    auto internString = [&](std::string_view view) -> uint32_t {
+        std::string value(view);
+        auto found = stringOffsets.find(value);
+        if (found != stringOffsets.end()) {
+            return found->second;
+        }
+        if (stringSection.size() > maxStoredSize || value.size() > maxStoredSize) {
+            stringsFit = false;
+            return 0;
+        }
+        uint32_t offset = static_cast<uint32_t>(stringSection.size());
+        appendValue<uint32_t>(stringSection, static_cast<uint32_t>(value.size()));
+        stringSection += value;
+        stringOffsets.emplace(value, offset);
+        return offset;
+    };
+
+    uint64_t assessmentCount = 0;
+    for (const Course& course : courses) {
+        assessmentCount += course.getAssessmentCount();
+    }
+
+    std::string courseSection;
+    std::string assessmentSection;
+    courseSection.reserve(courses.size() * courseRecordSizeV3);
+    assessmentSection.reserve(assessmentCount * assessmentRecordSize);
+
+    uint64_t firstAssessment = 0;
+    for (const Course& course : courses) {
+        appendValue<uint32_t>(courseSection, internString(course.getCourseCode()));
+        appendValue<uint32_t>(courseSection, course.getIsA5050Course() ? courseIs5050Flag : 0);
+        appendValue<uint64_t>(courseSection, firstAssessment);
+        appendValue<uint32_t>(courseSection, static_cast<uint32_t>(course.getAssessmentCount()));
+        appendValue<uint32_t>(courseSection, internString(course.getTerm()));
+        appendValue<double>(courseSection, course.getCredits());
+
+        for (const AssessmentView& assessment : course.getAssessments()) {
+            uint32_t flags = (assessment.getIsTheory() ? assessmentIsTheoryFlag : 0) |
+                             (assessment.getIsComplete() ? assessmentIsCompleteFlag : 0);
+            appendValue<double>(assessmentSection, assessment.getWeight());
+            appendValue<double>(assessmentSection, assessment.getGrade());
+            appendValue<uint32_t>(assessmentSection, internString(assessment.getName()));
+            appendValue<uint32_t>(assessmentSection, flags);
+        }
+        firstAssessment += course.getAssessmentCount();
+    }
+    if (!stringsFit) {
+        std::cerr << "Error: Could not write snapshot file at " << filePath << ": string table over 4 GiB" << std::endl;
+        return false;
+    }
+
+    std::string header(snapshotMagic, sizeof(snapshotMagic));
+    appendValue<uint32_t>(header, version);
+    appendValue<uint32_t>(header, static_cast<uint32_t>(courses.size()));
+    appendValue<uint64_t>(header, assessmentCount);
+    appendValue<uint64_t>(header, stringSection.size());
+    appendValue<uint64_t>(header, revision);
+
+    // write beside the target and rename over it so readers never see half a file,
+    // syncing both so the rename can't outlive the data on a power loss
+    std::string tempPath = filePath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not write snapshot file at " << tempPath << std::endl;
+            return false;
+        }
+        file.write(header.data(), header.size());
+        file.write(courseSection.data(), courseSection.size());
+        file.write(assessmentSection.data(), assessmentSection.size());
+        file.write(stringSection.data(), stringSection.size());
+        file.close();
+        if (!file.good() || !DurableFile::sync(tempPath)) {
+            std::cerr << "Error: Could not write snapshot file at " << tempPath << std::endl;
+            return false;
+        }
+    }
+
+    if (!DurableFile::replace(tempPath, filePath)) {
+        std::cerr << "Error: Could not replace snapshot file at " << filePath << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool CourseSnapshot::load(const std::string& filePath, std::vector<Course>& courses, uint64_t& revision) {
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::streamsize fileSize = file.tellg();
+    std::vector<char> bytes(static_cast<size_t>(fileSize));
+    file.seekg(0);
+    if (!file.read(bytes.data(), fileSize)) {
+        std::cerr << "Error loading snapshot: could not read " << filePath << std::endl;
+        return false;
+    }
+
+    SnapshotReader reader;
+    std::string error;
+    if (!reader.open(bytes.data(), bytes.size(), error)) {
+        std::cerr << "Error loading snapshot: " << error << std::endl;
+        return false;
+    }
+
+    std::vector<Course> loaded;
+    loaded.reserve(reader.getCourseCount());
+    for (uint32_t i = 0; i < reader.getCourseCount(); i++) {
+        loaded.push_back(reader.materialiseCourse(i));
+    }
+
+    courses = std::move(loaded);
+    revision = reader.getRevision();
+    return true;
+}
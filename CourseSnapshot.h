@@ -0,0 +1,81 @@
+#ifndef COURSE_SNAPSHOT_H
+#define COURSE_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Course.h"
+
+// Compact binary snapshot of every course, written next to the JSON data file so
+// startup doesn't have to build a JSON DOM. Layout (little-endian, host order):
+//
+//   header       magic "GRDSNAP1", u32 version, u32 courseCount,
+//                u64 assessmentCount, u64 stringBytes, u64 revision   (40 bytes)
+//   courses      u32 codeOffset, u32 flags, u64 firstAssessment,
+//                u32 assessmentCount, u32 termOffset, f64 credits     (32 bytes each)
+//   assessments  f64 weight, f64 grade, u32 nameOffset, u32 flags     (24 bytes each)
+//   strings      u32 length + bytes, addressed by the offsets above
+//
+// Every record is fixed width, so any course or assessment can be reached directly.
+// Repeated names ("Final", "Lab 1", ...) are written to the string section once.
+// revision is the last journal sequence folded into the snapshot; version 1 files
+// have a 32-byte header without it and read as revision 0. Versions 1 and 2 have
+// 24-byte course records ending in a reserved u32 instead of the term and credits,
+// and read with an empty term and the default credits.
+class SnapshotReader {
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+    uint32_t courseCount = 0;
+    uint64_t assessmentCount = 0;
+    const char* courseRecords = nullptr;
+    size_t courseRecordSize = 0; // depends on the file version
+    const char* assessmentRecords = nullptr;
+    const char* strings = nullptr;
+    uint64_t stringBytes = 0;
+    uint64_t revision = 0;
+
+    std::string_view readString(uint32_t offset) const;
+
+public:
+    // check the header and section sizes; the bytes must outlive the reader
+    bool open(const char* data, size_t size, std::string& error);
+
+    uint32_t getCourseCount() const { return courseCount; }
+    uint64_t getTotalAssessmentCount() const { return assessmentCount; }
+    uint64_t getRevision() const { return revision; }
+
+    std::string_view getCourseCode(uint32_t course) const;
+    bool getIsA5050Course(uint32_t course) const;
+    uint64_t getFirstAssessment(uint32_t course) const;
+    uint32_t getAssessmentCount(uint32_t course) const;
+    std::string_view getTerm(uint32_t course) const;
+    double getCredits(uint32_t course) const;
+
+    std::string_view getAssessmentName(uint64_t assessment) const;
+    double getAssessmentWeight(uint64_t assessment) const;
+    double getAssessmentGrade(uint64_t assessment) const;
+    bool getAssessmentIsTheory(uint64_t assessment) const;
+    bool getAssessmentIsComplete(uint64_t assessment) const;
+
+    // build an owning Course from one record
+    Course materialiseCourse(uint32_t course) const;
+    // the running totals that Course would hold for this record, without building
+    // one: the columns are gathered into per-thread scratch and summed by the same
+    // kernel, so the results match materialiseCourse's bit for bit
+    void sumCourseBuckets(uint32_t course, BucketSums& sums) const;
+};
+
+class CourseSnapshot {
+public:
+    static const uint32_t version = 3;
+
+    // false, leaving any existing file in place, if the file can't be written or
+    // the courses don't fit the format's 32-bit counts and string offsets
+    static bool save(const std::string& filePath, const std::vector<Course>& courses, uint64_t revision);
+    static bool load(const std::string& filePath, std::vector<Course>& courses, uint64_t& revision);
+};
+
+#endif
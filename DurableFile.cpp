@@ -0,0 +1,51 @@
+#include "DurableFile.h"
+#include <cstdio>
+#include <filesystem>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+bool DurableFile::sync(const std::string& filePath) {
+    #ifdef _WIN32
+        // FlushFileBuffers needs a handle with write access
+        HANDLE file = CreateFileA(filePath.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        bool synced = FlushFileBuffers(file) != 0;
+        CloseHandle(file);
+        return synced;
+    #else
+        int file = ::open(filePath.c_str(), O_RDONLY);
+        if (file < 0) {
+            return false;
+        }
+        bool synced = ::fsync(file) == 0;
+        ::close(file);
+        return synced;
+    #endif
+}
+
+bool DurableFile::replace(const std::string& tempPath, const std::string& filePath) {
+    #ifdef _WIN32
+        return MoveFileExA(tempPath.c_str(), filePath.c_str(),
+                           MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+    #else
+        if (std::rename(tempPath.c_str(), filePath.c_str()) != 0) {
+            return false;
+        }
+        std::string directory = std::filesystem::path(filePath).parent_path().string();
+        int handle = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY);
+        if (handle < 0) {
+            return false;
+        }
+        bool synced = ::fsync(handle) == 0;
+        ::close(handle);
+        return synced;
+    #endif
+}
@@ -0,0 +1,19 @@
+#ifndef DURABLE_FILE_H
+#define DURABLE_FILE_H
+
+#include <string>
+
+// The steps that make a write survive a power loss, not just a crash of this
+// process: a flushed stream only reaches the OS cache, and a rename only reaches
+// the disk once the directory holding it is synced.
+class DurableFile {
+public:
+    // force a closed or flushed file's data to disk (fsync, FlushFileBuffers)
+    static bool sync(const std::string& filePath);
+
+    // Rename a synced temp file over filePath, then sync the directory so the
+    // rename itself is on disk. On Windows the move is written through instead.
+    static bool replace(const std::string& tempPath, const std::string& filePath);
+};
+
+#endif
@@ -0,0 +1,324 @@
+#include "EditJournal.h"
+#include "DurableFile.h"
+#include "Course.h"
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace {
+
+const size_t frameHeaderSize = 4 + 8 + 1;
+const size_t checksumSize = 4;
+const uint32_t maxPayloadSize = 64u << 20; // anything bigger is a corrupt length
+
+template<typename T>
+void appendValue(std::string& buffer, T value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void appendString(std::string& buffer, std::string_view value) {
+    appendValue<uint32_t>(buffer, static_cast<uint32_t>(value.size()));
+    buffer += value;
+}
+
+void appendAssessment(std::string& buffer, const Assessment& assessment) {
+    appendString(buffer, assessment.getName());
+    appendValue<double>(buffer, assessment.getWeight());
+    appendValue<double>(buffer, assessment.getGrade());
+    appendValue<uint8_t>(buffer, (assessment.getIsTheory() ? 1 : 0) | (assessment.getIsComplete() ? 2 : 0));
+}
+
+// FNV-1a, enough to tell a torn write from a whole record
+uint32_t checksum(const char* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// bounds-checked reads over one record's payload
+class PayloadReader {
+private:
+    const char* data;
+    size_t size;
+    size_t position = 0;
+
+public:
+    PayloadReader(const char* data, size_t size) : data(data), size(size) {}
+
+    template<typename T>
+    bool read(T& value) {
+        if (size - position < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+
+    bool atEnd() const { return position == size; }
+
+    bool readString(std::string& value) {
+        uint32_t length;
+        if (!read(length) || size - position < length) {
+            return false;
+        }
+        value.assign(data + position, length);
+        position += length;
+        return true;
+    }
+
+    bool readAssessment(std::vector<Assessment>& assessments) {
+        std::string name;
+        double weight;
+        double grade;
+        uint8_t flags;
+        if (!readString(name) || !read(weight) || !read(grade) || !read(flags)) {
+            return false;
+        }
+        assessments.emplace_back(name, weight, grade, flags & 1, flags & 2);
+        return true;
+    }
+};
+
+void encodePayload(const JournalRecord& record, std::string& payload) {
+    using Type = JournalRecord::Type;
+
+    if (record.type != Type::AddCourse) {
+        appendValue<int32_t>(payload, record.courseIndex);
+    }
+
+    switch (record.type) {
+        case Type::AddCourse:
+            appendString(payload, record.text);
+            appendValue<uint8_t>(payload, record.flag ? 1 : 0);
+            appendValue<uint32_t>(payload, static_cast<uint32_t>(record.assessments.size()));
+            for (const Assessment& assessment : record.assessments) {
+                appendAssessment(payload, assessment);
+            }
+            appendValue<double>(payload, record.number);
+            appendString(payload, record.term);
+            break;
+        case Type::RemoveCourse:
+            break;
+        case Type::SetCourseCode:
+        case Type::SetCourseTerm:
+            appendString(payload, record.text);
+            break;
+        case Type::SetCourseCredits:
+            appendValue<double>(payload, record.number);
+            break;
+        case Type::SetIsA5050Course:
+            appendValue<uint8_t>(payload, record.flag ? 1 : 0);
+            break;
+        case Type::AddAssessment:
+            appendAssessment(payload, record.assessments.at(0));
+            break;
+        case Type::RemoveAssessment:
+            appendValue<int32_t>(payload, record.assessmentIndex);
+            break;
+        case Type::UpdateAssessmentName:
+            appendValue<int32_t>(payload, record.assessmentIndex);
+            appendString(payload, record.text);
+            break;
+        case Type::UpdateAssessmentWeight:
+        case Type::UpdateAssessmentGrade:
+            appendValue<int32_t>(payload, record.assessmentIndex);
+            appendValue<double>(payload, record.number);
+            break;
+        case Type::UpdateAssessmentType:
+        case Type::UpdateAssessmentCompletionStatus:
+            appendValue<int32_t>(payload, record.assessmentIndex);
+            appendValue<uint8_t>(payload, record.flag ? 1 : 0);
+            break;
+    }
+}
+
+bool decodePayload(PayloadReader& reader, JournalRecord& record) {
+    using Type = JournalRecord::Type;
+    int32_t courseIndex = -1;
+    int32_t assessmentIndex = -1;
+    uint8_t flag = 0;
+
+    if (record.type != Type::AddCourse && !reader.read(courseIndex)) {
+        return false;
+    }
+    record.courseIndex = courseIndex;
+
+    switch (record.type) {
+        case Type::AddCourse: {
+            uint32_t count;
+            if (!reader.readString(record.text) || !reader.read(flag) || !reader.read(count)) {
+                return false;
+            }
+            for (uint32_t i = 0; i < count; i++) {
+                if (!reader.readAssessment(record.assessments)) {
+                    return false;
+                }
+            }
+            // journals written before credits and terms end here
+            record.number = Course::defaultCredits;
+            if (!reader.atEnd() && (!reader.read(record.number) || !reader.readString(record.term))) {
+                return false;
+            }
+            break;
+        }
+        case Type::RemoveCourse:
+            break;
+        case Type::SetCourseCode:
+        case Type::SetCourseTerm:
+            return reader.readString(record.text);
+        case Type::SetCourseCredits:
+            return reader.read(record.number);
+        case Type::SetIsA5050Course:
+            if (!reader.read(flag)) {
+                return false;
+            }
+            break;
+        case Type::AddAssessment:
+            return reader.readAssessment(record.assessments);
+        case Type::RemoveAssessment:
+            if (!reader.read(assessmentIndex)) {
+                return false;
+            }
+            break;
+        case Type::UpdateAssessmentName:
+            if (!reader.read(assessmentIndex) || !reader.readString(record.text)) {
+                return false;
+            }
+            break;
+        case Type::UpdateAssessmentWeight:
+        case Type::UpdateAssessmentGrade:
+            if (!reader.read(assessmentIndex) || !reader.read(record.number)) {
+                return false;
+            }
+            break;
+        case Type::UpdateAssessmentType:
+        case Type::UpdateAssessmentCompletionStatus:
+            if (!reader.read(assessmentIndex) || !reader.read(flag)) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+
+    record.assessmentIndex = assessmentIndex;
+    record.flag = flag != 0;
+    return true;
+}
+
+} // namespace
+
+bool EditJournal::append(const JournalRecord& record) {
+    std::string payload;
+    encodePayload(record, payload);
+
+    std::string frame;
+    frame.reserve(frameHeaderSize + payload.size() + checksumSize);
+    appendValue<uint32_t>(frame, static_cast<uint32_t>(payload.size()));
+    appendValue<uint64_t>(frame, record.sequence);
+    appendValue<uint8_t>(frame, static_cast<uint8_t>(record.type));
+    frame += payload;
+    appendValue<uint32_t>(frame, checksum(frame.data() + 4, frame.size() - 4));
+
+    if (!file.is_open()) {
+        file.open(filePath, std::ios::binary | std::ios::app);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open journal file at " << filePath << std::endl;
+            return false;
+        }
+    }
+
+    file.write(frame.data(), frame.size());
+    file.flush(); // hand the record to the OS so a crash of this process can't lose it
+    if (!file.good()) {
+        std::cerr << "Error: Could not write journal file at " << filePath << std::endl;
+        file.close();
+        return false;
+    }
+    // and to the disk, so a power loss can't either
+    return !syncOnAppend || sync();
+}
+
+bool EditJournal::sync() {
+    if (!file.is_open()) {
+        return true; // nothing appended since the last reset or replay
+    }
+    file.flush();
+    if (!file.good() || !DurableFile::sync(filePath)) {
+        std::cerr << "Error: Could not sync journal file at " << filePath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+uint64_t EditJournal::replay(uint64_t afterSequence, bool trimTornTail,
+                            const std::function<void(const JournalRecord&)>& apply) {
+    file.close();
+
+    std::ifstream input(filePath, std::ios::binary);
+    if (!input.is_open()) {
+        return afterSequence;
+    }
+    std::string bytes((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+
+    uint64_t lastSequence = afterSequence;
+    size_t position = 0;
+    while (bytes.size() - position >= frameHeaderSize + checksumSize) {
+        uint32_t payloadSize;
+        std::memcpy(&payloadSize, bytes.data() + position, sizeof(payloadSize));
+        if (payloadSize > maxPayloadSize ||
+            bytes.size() - position < frameHeaderSize + payloadSize + checksumSize) {
+            break;
+        }
+
+        const char* frame = bytes.data() + position;
+        uint32_t storedChecksum;
+        std::memcpy(&storedChecksum, frame + frameHeaderSize + payloadSize, sizeof(storedChecksum));
+        if (storedChecksum != checksum(frame + 4, frameHeaderSize - 4 + payloadSize)) {
+            break;
+        }
+
+        JournalRecord record;
+        uint8_t type;
+        std::memcpy(&record.sequence, frame + 4, sizeof(record.sequence));
+        std::memcpy(&type, frame + 12, sizeof(type));
+        record.type = static_cast<JournalRecord::Type>(type);
+
+        PayloadReader reader(frame + frameHeaderSize, payloadSize);
+        if (!decodePayload(reader, record)) {
+            break;
+        }
+
+        if (record.sequence > lastSequence) {
+            apply(record);
+            lastSequence = record.sequence;
+        }
+        position += frameHeaderSize + payloadSize + checksumSize;
+    }
+
+    // cut a torn tail off so new records aren't appended after garbage
+    if (trimTornTail && position < bytes.size()) {
+        std::error_code error;
+        std::filesystem::resize_file(filePath, position, error);
+        if (error) {
+            std::cerr << "Error: Could not trim journal file at " << filePath << std::endl;
+        }
+    }
+
+    return lastSequence;
+}
+
+bool EditJournal::reset() {
+    file.close();
+    file.open(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not reset journal file at " << filePath << std::endl;
+        return false;
+    }
+    return true;
+}
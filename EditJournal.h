@@ -0,0 +1,72 @@
+#ifndef EDIT_JOURNAL_H
+#define EDIT_JOURNAL_H
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Assessment.h"
+
+// One edit, as recorded in the journal. Only the fields the type needs are used.
+struct JournalRecord {
+    enum class Type : uint8_t {
+        AddCourse = 1,
+        RemoveCourse,
+        SetCourseCode,
+        SetIsA5050Course,
+        AddAssessment,
+        RemoveAssessment,
+        UpdateAssessmentName,
+        UpdateAssessmentWeight,
+        UpdateAssessmentType,
+        UpdateAssessmentCompletionStatus,
+        UpdateAssessmentGrade,
+        SetCourseCredits,
+        SetCourseTerm
+    };
+
+    Type type = Type::AddCourse;
+    uint64_t sequence = 0;
+    int courseIndex = -1;
+    int assessmentIndex = -1;
+    std::string text;                    // course code, term or assessment name
+    std::string term;                    // AddCourse: the new course's term
+    double number = 0.0;                 // weight, grade or credits
+    bool flag = false;                   // 50/50, theory or completion flag
+    std::vector<Assessment> assessments; // AddCourse: the new course, AddAssessment: the new item
+};
+
+// Append-only log of edits on top of the last full save. Each record is framed as
+//   u32 payloadLength, u64 sequence, u8 type, payload, u32 checksum
+// and written with a single flush and sync, so an edit costs O(record) instead of
+// a full rewrite and is on disk once append returns. A torn or corrupt tail left
+// by a crash is detected by the checksum and cut off on the next replay that is
+// allowed to write.
+class EditJournal {
+private:
+    std::string filePath;
+    std::ofstream file;
+    bool syncOnAppend = true;
+
+public:
+    explicit EditJournal(const std::string& filePath) : filePath(filePath) {}
+
+    bool append(const JournalRecord& record);
+
+    // Without syncOnAppend, records only reach the OS cache until the next sync,
+    // for callers that make edits durable in batches instead of one at a time.
+    void setSyncOnAppend(bool enabled) { syncOnAppend = enabled; }
+    bool sync();
+
+    // Feed every intact record with sequence > afterSequence to apply, in order,
+    // stopping at the first torn or corrupt one; trimTornTail also truncates the
+    // file there. Returns the highest sequence seen (afterSequence if none).
+    uint64_t replay(uint64_t afterSequence, bool trimTornTail,
+                    const std::function<void(const JournalRecord&)>& apply);
+
+    // drop all records, called once they are folded into a full save
+    bool reset();
+};
+
+#endif
@@ -0,0 +1,213 @@
+#include "GpaTracker.h"
+#include <utility>
+
+GpaTracker::GpaTracker(CourseManager& manager, GradeScale scale)
+    : manager(manager), scale(std::move(scale)) {
+    listenerId = manager.addChangeListener([this](const CourseChange& change) { onChange(change); });
+}
+
+GpaTracker::~GpaTracker() {
+    manager.removeChangeListener(listenerId);
+}
+
+void GpaTracker::setGradeScale(GradeScale newScale) {
+    std::lock_guard<std::mutex> lock(mutex);
+    scale = std::move(newScale);
+    stale = true;
+}
+
+void GpaTracker::setIncludeInProgress(bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex);
+    includeInProgress = enabled;
+    stale = true;
+}
+
+// contributions
+GpaTracker::Contribution GpaTracker::makeContribution(const Course& course, const GradeScale& scale,
+                                                      bool includeInProgress) {
+    GradeSummary summary = course.calculateSummary(true);
+
+    Contribution contribution;
+    contribution.credits = course.getCredits();
+    contribution.term = course.getTerm();
+    if (includeInProgress) {
+        contribution.counted = summary.completeWeight > 0.0;
+    } else {
+        contribution.counted = summary.incompleteCount == 0 && summary.isTotalWeightValid;
+    }
+    contribution.counted = contribution.counted && contribution.credits > 0.0;
+    if (contribution.counted) {
+        contribution.points = scale.getPoints(summary.gradeSoFar);
+    }
+    return contribution;
+}
+
+void GpaTracker::addTo(GpaTotals& totals, const Contribution& contribution, int sign) {
+    if (!contribution.counted) {
+        return;
+    }
+    totals.courseCount += sign;
+    if (totals.courseCount == 0) {
+        totals = GpaTotals(); // no rounding residue once the last course leaves
+        return;
+    }
+    totals.qualityPoints += sign * contribution.points * contribution.credits;
+    totals.credits += sign * contribution.credits;
+}
+
+void GpaTracker::include(const Contribution& contribution) const {
+    if (contribution.counted) {
+        addTo(cumulative, contribution, 1);
+        addTo(terms[contribution.term], contribution, 1);
+    }
+}
+
+void GpaTracker::exclude(const Contribution& contribution) const {
+    if (contribution.counted) {
+        addTo(cumulative, contribution, -1);
+        addTo(terms[contribution.term], contribution, -1);
+    }
+}
+
+void GpaTracker::apply(CourseChange::Type type, int courseIndex, Contribution contribution) const {
+    bool isKnownIndex = courseIndex >= 0 && courseIndex < static_cast<int>(entries.size());
+    switch (type) {
+        case CourseChange::Type::Edited:
+            if (!isKnownIndex) {
+                stale = true;
+                return;
+            }
+            exclude(entries[courseIndex]);
+            include(contribution);
+            entries[courseIndex] = std::move(contribution);
+            break;
+        case CourseChange::Type::Added:
+            if (courseIndex != static_cast<int>(entries.size())) {
+                stale = true;
+                return;
+            }
+            include(contribution);
+            entries.push_back(std::move(contribution));
+            break;
+        case CourseChange::Type::Removed:
+            if (!isKnownIndex) {
+                stale = true;
+                return;
+            }
+            exclude(entries[courseIndex]);
+            entries.erase(entries.begin() + courseIndex);
+            break;
+        default:
+            stale = true;
+            break;
+    }
+}
+
+// listener, runs under the manager's locks
+void GpaTracker::onChange(const CourseChange& change) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (change.type == CourseChange::Type::Reloaded) {
+        stale = true;
+        return;
+    }
+    if (stale && !rebuilding) {
+        return; // the next rebuild reads this edit from the manager
+    }
+
+    Contribution contribution;
+    if (change.course) {
+        contribution = makeContribution(*change.course, scale, includeInProgress);
+    }
+    if (rebuilding) {
+        pending.push_back({change.type, change.courseIndex, change.sequence, std::move(contribution)});
+        return;
+    }
+    apply(change.type, change.courseIndex, std::move(contribution));
+}
+
+// Reads the manager with no tracker lock held, since listeners take mutex under
+// the manager's locks. Edits heard meanwhile are queued and those newer than the
+// snapshot replayed on top; a reload or setter meanwhile starts another round.
+void GpaTracker::rebuildIfStale() const {
+    std::lock_guard<std::mutex> rebuildLock(rebuildMutex);
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!stale) {
+                return;
+            }
+            stale = false;
+            rebuilding = true;
+            pending.clear();
+        }
+
+        uint64_t revision;
+        std::vector<Course> courses = manager.getCoursesSnapshot(revision);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+        entries.reserve(courses.size());
+        terms.clear();
+        cumulative = GpaTotals();
+        for (const Course& course : courses) {
+            entries.push_back(makeContribution(course, scale, includeInProgress));
+            include(entries.back());
+        }
+        for (PendingChange& change : pending) {
+            if (change.sequence > revision) {
+                apply(change.type, change.courseIndex, std::move(change.contribution));
+            }
+        }
+        pending.clear();
+        rebuilding = false;
+    }
+}
+
+// queries
+GpaTotals GpaTracker::getCumulative() const {
+    rebuildIfStale();
+    std::lock_guard<std::mutex> lock(mutex);
+    return cumulative;
+}
+
+GpaTotals GpaTracker::getTerm(const std::string& term) const {
+    rebuildIfStale();
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = terms.find(term);
+    return found != terms.end() ? found->second : GpaTotals();
+}
+
+std::vector<TermGpa> GpaTracker::getTerms() const {
+    rebuildIfStale();
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<TermGpa> result;
+    for (const auto& entry : terms) {
+        if (entry.second.courseCount > 0) {
+            result.push_back({entry.first, entry.second});
+        }
+    }
+    return result;
+}
+
+GpaTotals GpaTracker::calculate(const Course* courses, size_t courseCount, const GradeScale& scale,
+                                bool includeInProgress, std::vector<TermGpa>* terms) {
+    GpaTotals cumulative;
+    std::map<std::string, GpaTotals> byTerm;
+    for (size_t i = 0; i < courseCount; i++) {
+        Contribution contribution = makeContribution(courses[i], scale, includeInProgress);
+        if (!contribution.counted) {
+            continue;
+        }
+        addTo(cumulative, contribution, 1);
+        if (terms) {
+            addTo(byTerm[contribution.term], contribution, 1);
+        }
+    }
+    if (terms) {
+        terms->clear();
+        for (const auto& entry : byTerm) {
+            terms->push_back({entry.first, entry.second});
+        }
+    }
+    return cumulative;
+}
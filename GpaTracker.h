@@ -0,0 +1,100 @@
+#ifndef GPA_TRACKER_H
+#define GPA_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Course.h"
+#include "CourseManager.h"
+#include "GradeScale.h"
+
+// Credit-weighted grade points over a set of courses.
+struct GpaTotals {
+    double qualityPoints = 0.0; // sum of points * credits
+    double credits = 0.0;
+    int courseCount = 0;
+
+    double getGpa() const { return credits > 0.0 ? qualityPoints / credits : 0.0; }
+};
+
+struct TermGpa {
+    std::string term; // empty for courses without a term
+    GpaTotals totals;
+};
+
+// Term and cumulative GPA over every course of a CourseManager, kept current
+// through its change listener: an edit to one course moves only that course's
+// contribution in and out of the totals instead of recomputing every course.
+// A load or a direct edit (markDirty) marks everything stale, and the next query
+// rebuilds from a consistent snapshot of the manager.
+//
+// By default a course counts once it is finished: nothing incomplete and its
+// weights summing to 100%. With includeInProgress it counts as soon as anything
+// is graded, at its grade so far. Courses with no credits never count.
+class GpaTracker {
+private:
+    // what one course adds to the totals
+    struct Contribution {
+        bool counted = false;
+        double points = 0.0;
+        double credits = 0.0;
+        std::string term;
+    };
+    // an edit heard while a rebuild was reading the manager
+    struct PendingChange {
+        CourseChange::Type type;
+        int courseIndex;
+        uint64_t sequence;
+        Contribution contribution;
+    };
+
+    CourseManager& manager;
+    int listenerId;
+    GradeScale scale;
+    bool includeInProgress = false;
+
+    // mutex guards the scale, the flag and everything below; rebuildMutex lets
+    // one query rebuild at a time without holding mutex while it reads the manager
+    mutable std::mutex mutex;
+    mutable std::mutex rebuildMutex;
+    mutable std::vector<Contribution> entries; // by course index
+    mutable std::map<std::string, GpaTotals> terms;
+    mutable GpaTotals cumulative;
+    mutable bool stale = true;
+    mutable bool rebuilding = false;
+    mutable std::vector<PendingChange> pending;
+
+    static Contribution makeContribution(const Course& course, const GradeScale& scale, bool includeInProgress);
+    static void addTo(GpaTotals& totals, const Contribution& contribution, int sign);
+    void include(const Contribution& contribution) const;
+    void exclude(const Contribution& contribution) const;
+    void apply(CourseChange::Type type, int courseIndex, Contribution contribution) const; // caller holds mutex
+
+    void onChange(const CourseChange& change);
+    void rebuildIfStale() const;
+
+public:
+    explicit GpaTracker(CourseManager& manager, GradeScale scale = GradeScale::makeDefault());
+    ~GpaTracker();
+    GpaTracker(const GpaTracker&) = delete;
+    GpaTracker& operator=(const GpaTracker&) = delete;
+
+    //setter, each forces a rebuild on the next query
+    void setGradeScale(GradeScale newScale);
+    void setIncludeInProgress(bool enabled);
+
+    //getter
+    GpaTotals getCumulative() const;
+    GpaTotals getTerm(const std::string& term) const; // all zero for an unknown term
+    std::vector<TermGpa> getTerms() const;            // sorted by term, terms with no counted course left out
+
+    // The same figures computed from scratch over a list of courses, for one-off
+    // reports. terms may be null.
+    static GpaTotals calculate(const Course* courses, size_t courseCount, const GradeScale& scale,
+                               bool includeInProgress, std::vector<TermGpa>* terms);
+};
+
+#endif
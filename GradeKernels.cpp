@@ -0,0 +1,283 @@
+#include "GradeKernels.h"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define GRADE_KERNELS_X86 1
+    #include <immintrin.h>
+#endif
+
+namespace {
+
+inline int countBits(uint64_t word) {
+    #ifdef __GNUC__
+        return __builtin_popcountll(word);
+    #else
+        int bits = 0;
+        for (; word; word &= word - 1) {
+            bits++;
+        }
+        return bits;
+    #endif
+}
+
+// the flags of assessments first .. first + width - 1, which never straddle a word
+inline uint64_t groupBits(const uint64_t* mask, size_t first, int width) {
+    return (mask[first / 64] >> (first % 64)) & ((1u << width) - 1);
+}
+
+// counts straight from the masks, one popcount per word and bucket
+void countBuckets(const uint64_t* theoryMask, const uint64_t* completeMask, size_t count, BucketSums& sums) {
+    for (size_t word = 0; word * 64 < count; word++) {
+        size_t remaining = count - word * 64;
+        uint64_t valid = remaining >= 64 ? ~0ULL : (1ULL << remaining) - 1;
+        uint64_t theory = theoryMask[word] & valid;
+        uint64_t complete = completeMask[word] & valid;
+
+        sums.count[1][1] += countBits(theory & complete);
+        sums.count[1][0] += countBits(theory & ~complete);
+        sums.count[0][1] += countBits(~theory & complete & valid);
+        sums.count[0][0] += countBits(~theory & ~complete & valid);
+    }
+}
+
+void sumScalar(const double* weights, const double* grades, const uint64_t* theoryMask,
+               const uint64_t* completeMask, size_t first, size_t count, BucketSums& sums) {
+    for (size_t i = first; i < count; i++) {
+        int isTheory = (theoryMask[i / 64] >> (i % 64)) & 1;
+        int isComplete = (completeMask[i / 64] >> (i % 64)) & 1;
+        sums.weightedGrade[isTheory][isComplete] += weights[i] * grades[i];
+        sums.weight[isTheory][isComplete] += weights[i];
+    }
+}
+
+#ifdef GRADE_KERNELS_X86
+
+// lanes[bits][l] is all ones when bit l of bits is set
+struct alignas(32) LaneMaskTable {
+    double lanes[16][4];
+
+    LaneMaskTable() {
+        for (int bits = 0; bits < 16; bits++) {
+            for (int lane = 0; lane < 4; lane++) {
+                uint64_t value = (bits >> lane) & 1 ? ~0ULL : 0;
+                std::memcpy(&lanes[bits][lane], &value, sizeof(double));
+            }
+        }
+    }
+};
+
+// built once on first use; a table load per flag group is cheaper than
+// broadcasting the bits and comparing them lane by lane
+const LaneMaskTable& getLaneMasks() {
+    static const LaneMaskTable laneMasks;
+    return laneMasks;
+}
+
+// The eight accumulators (grade and weight per bucket) live in a small struct that
+// the always-inlined group step takes by reference, so after inlining they stay in
+// registers. Flags are read a whole mask word at a time and shifted down group by
+// group; a variable shift per group costs more than the arithmetic it feeds.
+
+struct Sse2Accumulators {
+    __m128d labPendingGrade, labPendingWeight, labCompleteGrade, labCompleteWeight;
+    __m128d theoryPendingGrade, theoryPendingWeight, theoryCompleteGrade, theoryCompleteWeight;
+};
+
+__attribute__((target("sse2"), always_inline))
+inline void accumulateSse2(Sse2Accumulators& sum, const double* weights, const double* grades,
+                           const double* theoryLanes, const double* completeLanes) {
+    __m128d w = _mm_loadu_pd(weights);
+    __m128d product = _mm_mul_pd(w, _mm_loadu_pd(grades));
+    __m128d theory = _mm_load_pd(theoryLanes);
+    __m128d complete = _mm_load_pd(completeLanes);
+
+    __m128d theoryComplete = _mm_and_pd(theory, complete);
+    __m128d theoryPending = _mm_andnot_pd(complete, theory);
+    __m128d labComplete = _mm_andnot_pd(theory, complete);
+    __m128d labPending = _mm_andnot_pd(_mm_or_pd(theory, complete), _mm_castsi128_pd(_mm_set1_epi32(-1)));
+
+    sum.theoryCompleteGrade = _mm_add_pd(sum.theoryCompleteGrade, _mm_and_pd(product, theoryComplete));
+    sum.theoryCompleteWeight = _mm_add_pd(sum.theoryCompleteWeight, _mm_and_pd(w, theoryComplete));
+    sum.theoryPendingGrade = _mm_add_pd(sum.theoryPendingGrade, _mm_and_pd(product, theoryPending));
+    sum.theoryPendingWeight = _mm_add_pd(sum.theoryPendingWeight, _mm_and_pd(w, theoryPending));
+    sum.labCompleteGrade = _mm_add_pd(sum.labCompleteGrade, _mm_and_pd(product, labComplete));
+    sum.labCompleteWeight = _mm_add_pd(sum.labCompleteWeight, _mm_and_pd(w, labComplete));
+    sum.labPendingGrade = _mm_add_pd(sum.labPendingGrade, _mm_and_pd(product, labPending));
+    sum.labPendingWeight = _mm_add_pd(sum.labPendingWeight, _mm_and_pd(w, labPending));
+}
+
+__attribute__((target("sse2")))
+inline double reduceSse2(__m128d value) {
+    return _mm_cvtsd_f64(_mm_add_sd(value, _mm_unpackhi_pd(value, value)));
+}
+
+__attribute__((target("sse2")))
+void sumSse2(const double* weights, const double* grades, const uint64_t* theoryMask,
+             const uint64_t* completeMask, size_t count, BucketSums& sums) {
+    const LaneMaskTable& laneMasks = getLaneMasks(); // first two lanes of each row
+    __m128d zero = _mm_setzero_pd();
+    Sse2Accumulators sum = {zero, zero, zero, zero, zero, zero, zero, zero};
+
+    size_t i = 0;
+    for (; i + 64 <= count; i += 64) {
+        uint64_t theoryWord = theoryMask[i / 64];
+        uint64_t completeWord = completeMask[i / 64];
+        for (size_t group = i; group < i + 64; group += 2) {
+            accumulateSse2(sum, weights + group, grades + group,
+                           laneMasks.lanes[theoryWord & 3], laneMasks.lanes[completeWord & 3]);
+            theoryWord >>= 2;
+            completeWord >>= 2;
+        }
+    }
+    for (; i + 2 <= count; i += 2) {
+        accumulateSse2(sum, weights + i, grades + i,
+                       laneMasks.lanes[groupBits(theoryMask, i, 2)], laneMasks.lanes[groupBits(completeMask, i, 2)]);
+    }
+
+    sums.weightedGrade[0][0] += reduceSse2(sum.labPendingGrade);
+    sums.weight[0][0] += reduceSse2(sum.labPendingWeight);
+    sums.weightedGrade[0][1] += reduceSse2(sum.labCompleteGrade);
+    sums.weight[0][1] += reduceSse2(sum.labCompleteWeight);
+    sums.weightedGrade[1][0] += reduceSse2(sum.theoryPendingGrade);
+    sums.weight[1][0] += reduceSse2(sum.theoryPendingWeight);
+    sums.weightedGrade[1][1] += reduceSse2(sum.theoryCompleteGrade);
+    sums.weight[1][1] += reduceSse2(sum.theoryCompleteWeight);
+    sumScalar(weights, grades, theoryMask, completeMask, i, count, sums);
+}
+
+struct Avx2Accumulators {
+    __m256d labPendingGrade, labPendingWeight, labCompleteGrade, labCompleteWeight;
+    __m256d theoryPendingGrade, theoryPendingWeight, theoryCompleteGrade, theoryCompleteWeight;
+};
+
+__attribute__((target("avx2"), always_inline))
+inline void accumulateAvx2(Avx2Accumulators& sum, const double* weights, const double* grades,
+                           const double* theoryLanes, const double* completeLanes) {
+    __m256d w = _mm256_loadu_pd(weights);
+    __m256d product = _mm256_mul_pd(w, _mm256_loadu_pd(grades));
+    __m256d theory = _mm256_load_pd(theoryLanes);
+    __m256d complete = _mm256_load_pd(completeLanes);
+
+    __m256d theoryComplete = _mm256_and_pd(theory, complete);
+    __m256d theoryPending = _mm256_andnot_pd(complete, theory);
+    __m256d labComplete = _mm256_andnot_pd(theory, complete);
+    __m256d labPending = _mm256_andnot_pd(_mm256_or_pd(theory, complete),
+                                          _mm256_castsi256_pd(_mm256_set1_epi64x(-1)));
+
+    sum.theoryCompleteGrade = _mm256_add_pd(sum.theoryCompleteGrade, _mm256_and_pd(product, theoryComplete));
+    sum.theoryCompleteWeight = _mm256_add_pd(sum.theoryCompleteWeight, _mm256_and_pd(w, theoryComplete));
+    sum.theoryPendingGrade = _mm256_add_pd(sum.theoryPendingGrade, _mm256_and_pd(product, theoryPending));
+    sum.theoryPendingWeight = _mm256_add_pd(sum.theoryPendingWeight, _mm256_and_pd(w, theoryPending));
+    sum.labCompleteGrade = _mm256_add_pd(sum.labCompleteGrade, _mm256_and_pd(product, labComplete));
+    sum.labCompleteWeight = _mm256_add_pd(sum.labCompleteWeight, _mm256_and_pd(w, labComplete));
+    sum.labPendingGrade = _mm256_add_pd(sum.labPendingGrade, _mm256_and_pd(product, labPending));
+    sum.labPendingWeight = _mm256_add_pd(sum.labPendingWeight, _mm256_and_pd(w, labPending));
+}
+
+__attribute__((target("avx2")))
+inline double reduceAvx2(__m256d value) {
+    __m128d pairs = _mm_add_pd(_mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pairs, _mm_unpackhi_pd(pairs, pairs)));
+}
+
+__attribute__((target("avx2")))
+void sumAvx2(const double* weights, const double* grades, const uint64_t* theoryMask,
+             const uint64_t* completeMask, size_t count, BucketSums& sums) {
+    const LaneMaskTable& laneMasks = getLaneMasks();
+    __m256d zero = _mm256_setzero_pd();
+    Avx2Accumulators sum = {zero, zero, zero, zero, zero, zero, zero, zero};
+
+    size_t i = 0;
+    for (; i + 64 <= count; i += 64) {
+        uint64_t theoryWord = theoryMask[i / 64];
+        uint64_t completeWord = completeMask[i / 64];
+        for (size_t group = i; group < i + 64; group += 4) {
+            accumulateAvx2(sum, weights + group, grades + group,
+                           laneMasks.lanes[theoryWord & 15], laneMasks.lanes[completeWord & 15]);
+            theoryWord >>= 4;
+            completeWord >>= 4;
+        }
+    }
+    for (; i + 4 <= count; i += 4) {
+        accumulateAvx2(sum, weights + i, grades + i,
+                       laneMasks.lanes[groupBits(theoryMask, i, 4)], laneMasks.lanes[groupBits(completeMask, i, 4)]);
+    }
+
+    sums.weightedGrade[0][0] += reduceAvx2(sum.labPendingGrade);
+    sums.weight[0][0] += reduceAvx2(sum.labPendingWeight);
+    sums.weightedGrade[0][1] += reduceAvx2(sum.labCompleteGrade);
+    sums.weight[0][1] += reduceAvx2(sum.labCompleteWeight);
+    sums.weightedGrade[1][0] += reduceAvx2(sum.theoryPendingGrade);
+    sums.weight[1][0] += reduceAvx2(sum.theoryPendingWeight);
+    sums.weightedGrade[1][1] += reduceAvx2(sum.theoryCompleteGrade);
+    sums.weight[1][1] += reduceAvx2(sum.theoryCompleteWeight);
+
+    // the scalar tail is legacy SSE code; clear the upper halves first or every
+    // SSE instruction after this pays the AVX transition penalty
+    _mm256_zeroupper();
+    sumScalar(weights, grades, theoryMask, completeMask, i, count, sums);
+}
+
+#endif
+
+GradeKernels::Implementation detectImplementation() {
+    #ifdef GRADE_KERNELS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return GradeKernels::Implementation::Avx2;
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return GradeKernels::Implementation::Sse2;
+        }
+    #endif
+    return GradeKernels::Implementation::Scalar;
+}
+
+}
+
+void GradeKernels::sumBuckets(const double* weights, const double* grades, const uint64_t* theoryMask,
+                              const uint64_t* completeMask, size_t count, BucketSums& sums) {
+    sumBuckets(getActiveImplementation(), weights, grades, theoryMask, completeMask, count, sums);
+}
+
+void GradeKernels::sumBuckets(Implementation implementation, const double* weights, const double* grades,
+                              const uint64_t* theoryMask, const uint64_t* completeMask, size_t count,
+                              BucketSums& sums) {
+    sums = BucketSums();
+    if (count == 0) {
+        return;
+    }
+    countBuckets(theoryMask, completeMask, count, sums);
+
+    #ifdef GRADE_KERNELS_X86
+        if (implementation == Implementation::Avx2 && isSupported(Implementation::Avx2)) {
+            sumAvx2(weights, grades, theoryMask, completeMask, count, sums);
+            return;
+        }
+        if (implementation != Implementation::Scalar && isSupported(Implementation::Sse2)) {
+            sumSse2(weights, grades, theoryMask, completeMask, count, sums);
+            return;
+        }
+    #endif
+    sumScalar(weights, grades, theoryMask, completeMask, 0, count, sums);
+}
+
+GradeKernels::Implementation GradeKernels::getActiveImplementation() {
+    static const Implementation active = detectImplementation(); // thread-safe once
+    return active;
+}
+
+bool GradeKernels::isSupported(Implementation implementation) {
+    return implementation <= getActiveImplementation();
+}
+
+const char* GradeKernels::getName(Implementation implementation) {
+    switch (implementation) {
+        case Implementation::Avx2:
+            return "avx2";
+        case Implementation::Sse2:
+            return "sse2";
+        default:
+            return "scalar";
+    }
+}
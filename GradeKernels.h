@@ -0,0 +1,37 @@
+#ifndef GRADE_KERNELS_H
+#define GRADE_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Weighted-grade and weight sums per [isTheory][isComplete] bucket, the same
+// split Course keeps as running totals.
+struct BucketSums {
+    double weightedGrade[2][2] = {{0.0, 0.0}, {0.0, 0.0}};
+    double weight[2][2] = {{0.0, 0.0}, {0.0, 0.0}};
+    int count[2][2] = {{0, 0}, {0, 0}};
+};
+
+// Masked multiply-accumulate over AssessmentStore's columns: weights and grades
+// as contiguous doubles, the flags as bit masks of 64 assessments per word.
+// Every element lands in exactly one bucket, so there is no per-element branch;
+// sumBuckets picks the widest implementation the CPU supports at first use.
+class GradeKernels {
+public:
+    enum class Implementation { Scalar, Sse2, Avx2 };
+
+    static void sumBuckets(const double* weights, const double* grades, const uint64_t* theoryMask,
+                           const uint64_t* completeMask, size_t count, BucketSums& sums);
+
+    // the individual paths, for benchmarks and cross-checks; an unsupported
+    // implementation falls back to the next narrower one
+    static void sumBuckets(Implementation implementation, const double* weights, const double* grades,
+                           const uint64_t* theoryMask, const uint64_t* completeMask, size_t count,
+                           BucketSums& sums);
+
+    static Implementation getActiveImplementation();
+    static bool isSupported(Implementation implementation);
+    static const char* getName(Implementation implementation);
+};
+
+#endif
@@ -0,0 +1,61 @@
+#include "GradeScale.h"
+#include <algorithm>
+
+GradeScale GradeScale::makeDefault() {
+    GradeScale scale;
+    scale.addStep(90, 4.33, "A+");
+    scale.addStep(85, 4.00, "A");
+    scale.addStep(80, 3.67, "A-");
+    scale.addStep(77, 3.33, "B+");
+    scale.addStep(73, 3.00, "B");
+    scale.addStep(70, 2.67, "B-");
+    scale.addStep(67, 2.33, "C+");
+    scale.addStep(63, 2.00, "C");
+    scale.addStep(60, 1.67, "C-");
+    scale.addStep(57, 1.33, "D+");
+    scale.addStep(53, 1.00, "D");
+    scale.addStep(50, 0.67, "D-");
+    scale.addStep(0, 0.00, "F");
+    return scale;
+}
+
+GradeScale GradeScale::makeFourPoint() {
+    GradeScale scale;
+    scale.addStep(80, 4.0, "A");
+    scale.addStep(70, 3.0, "B");
+    scale.addStep(60, 2.0, "C");
+    scale.addStep(50, 1.0, "D");
+    scale.addStep(0, 0.0, "F");
+    return scale;
+}
+
+void GradeScale::addStep(double minimumPercent, double points, const std::string& letter) {
+    auto position = std::find_if(steps.begin(), steps.end(), [minimumPercent](const Step& step) {
+        return step.minimumPercent <= minimumPercent;
+    });
+    if (position != steps.end() && position->minimumPercent == minimumPercent) {
+        position->points = points;
+        position->letter = letter;
+        return;
+    }
+    steps.insert(position, {minimumPercent, points, letter});
+}
+
+// a handful of steps, so a scan beats anything cleverer
+double GradeScale::getPoints(double percent) const {
+    for (const Step& step : steps) {
+        if (percent >= step.minimumPercent) {
+            return step.points;
+        }
+    }
+    return 0.0;
+}
+
+std::string GradeScale::getLetter(double percent) const {
+    for (const Step& step : steps) {
+        if (percent >= step.minimumPercent) {
+            return step.letter;
+        }
+    }
+    return "F";
+}
@@ -0,0 +1,37 @@
+#ifndef GRADE_SCALE_H
+#define GRADE_SCALE_H
+
+#include <string>
+#include <vector>
+
+// Maps a course percentage to grade points and a letter. A grade earns the
+// step with the highest minimum it reaches; below every step it earns 0.
+class GradeScale {
+public:
+    struct Step {
+        double minimumPercent;
+        double points;
+        std::string letter;
+    };
+
+private:
+    std::vector<Step> steps; // highest minimum first
+
+public:
+    GradeScale() = default;
+
+    // A+ 4.33 at 90% down to D- 0.67 at 50%, F below
+    static GradeScale makeDefault();
+    // A 4.0 at 80%, B 3.0 at 70%, C 2.0 at 60%, D 1.0 at 50%, F below
+    static GradeScale makeFourPoint();
+
+    // replaces a step with the same minimum
+    void addStep(double minimumPercent, double points, const std::string& letter);
+
+    //getter
+    double getPoints(double percent) const;
+    std::string getLetter(double percent) const; // "F" below every step
+    const std::vector<Step>& getSteps() const { return steps; }
+};
+
+#endif
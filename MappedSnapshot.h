@@ -0,0 +1,97 @@
+#ifndef MAPPED_SNAPSHOT_H
+#define MAPPED_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CourseSnapshot.h"
+
+// Read-only view of one assessment record inside a mapped snapshot.
+class MappedAssessmentView {
+private:
+    const SnapshotReader* reader;
+    uint64_t index;
+
+public:
+    MappedAssessmentView(const SnapshotReader* reader, uint64_t index) : reader(reader), index(index) {}
+
+    std::string_view getName() const { return reader->getAssessmentName(index); }
+    double getWeight() const { return reader->getAssessmentWeight(index); }
+    double getGrade() const { return reader->getAssessmentGrade(index); }
+    bool getIsTheory() const { return reader->getAssessmentIsTheory(index); }
+    bool getIsComplete() const { return reader->getAssessmentIsComplete(index); }
+};
+
+// Read-only view of one course record inside a mapped snapshot.
+class MappedCourseView {
+private:
+    const SnapshotReader* reader;
+    uint32_t index;
+
+public:
+    MappedCourseView(const SnapshotReader* reader, uint32_t index) : reader(reader), index(index) {}
+
+    std::string_view getCourseCode() const { return reader->getCourseCode(index); }
+    bool getIsA5050Course() const { return reader->getIsA5050Course(index); }
+    int getAssessmentCount() const { return static_cast<int>(reader->getAssessmentCount(index)); }
+    std::string_view getTerm() const { return reader->getTerm(index); }
+    double getCredits() const { return reader->getCredits(index); }
+    MappedAssessmentView getAssessment(int assessment) const {
+        return MappedAssessmentView(reader, reader->getFirstAssessment(index) + assessment);
+    }
+
+    // grade queries straight from the mapped columns, matching Course's; sum the
+    // buckets once and use Course's static queries when asking several
+    void sumBuckets(BucketSums& totals) const { reader->sumCourseBuckets(index, totals); }
+    GradeSummary calculateSummary(bool careForComplete) const {
+        BucketSums totals;
+        sumBuckets(totals);
+        return Course::calculateSummary(totals, careForComplete);
+    }
+    double calculateRequiredUniformGrade(double goal, bool& isAchievable) const {
+        BucketSums totals;
+        sumBuckets(totals);
+        return Course::calculateRequiredUniformGrade(totals, goal, isAchievable);
+    }
+    void calculateRequiredUniformGrades(const std::vector<double>& goals, double* requiredGrades,
+                                        uint8_t* isAchievable) const {
+        BucketSums totals;
+        sumBuckets(totals);
+        Course::calculateRequiredUniformGrades(totals, goals, requiredGrades, isAchievable);
+    }
+
+    // owning copy of just this course, e.g. to edit it
+    Course toCourse() const { return reader->materialiseCourse(index); }
+};
+
+// Maps a snapshot file into memory read-only. Nothing is copied or parsed beyond
+// the header, so pages are faulted in (and shared between processes) on demand.
+class MappedSnapshot {
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+    SnapshotReader reader;
+
+    #ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+    #endif
+
+public:
+    MappedSnapshot() = default;
+    ~MappedSnapshot();
+    MappedSnapshot(const MappedSnapshot&) = delete;
+    MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+    bool open(const std::string& filePath);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    int getCourseCount() const { return static_cast<int>(reader.getCourseCount()); }
+    uint64_t getRevision() const { return reader.getRevision(); }
+    MappedCourseView getCourse(int index) const { return MappedCourseView(&reader, static_cast<uint32_t>(index)); }
+};
+
+#endif
@@ -0,0 +1,297 @@
+#include "MonteCarlo.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace {
+
+// xoshiro256** by Blackman and Vigna: four words of state, a few cycles per
+// number, and good enough statistics for simulation (not for secrets).
+class Xoshiro256 {
+private:
+    uint64_t state[4];
+
+    static uint64_t rotateLeft(uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+public:
+    // splitmix64 spreads a small seed over the whole state, as the authors advise
+    explicit Xoshiro256(uint64_t seed) {
+        for (uint64_t& word : state) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t mixed = seed;
+            mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebULL;
+            word = mixed ^ (mixed >> 31);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+        uint64_t shifted = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= shifted;
+        state[3] = rotateLeft(state[3], 45);
+        return result;
+    }
+
+    // uniform in [0, 1) from the top 53 bits
+    double nextDouble() {
+        return (next() >> 11) * 0x1.0p-53;
+    }
+};
+
+// Box-Muller pairs, rejecting draws outside [0, 100] (a truncated normal)
+void sampleTruncatedNormal(Xoshiro256& random, MonteCarlo::Distribution distribution, double* values, int count) {
+    const double twoPi = 6.283185307179586;
+    int filled = 0;
+    while (filled < count) {
+        double radius = std::sqrt(-2.0 * std::log(1.0 - random.nextDouble())); // 1 - u avoids log(0)
+        double angle = twoPi * random.nextDouble();
+
+        double first = distribution.mean + distribution.standardDeviation * radius * std::cos(angle);
+        if (first >= 0.0 && first <= 100.0) {
+            values[filled++] = first;
+        }
+        double second = distribution.mean + distribution.standardDeviation * radius * std::sin(angle);
+        if (filled < count && second >= 0.0 && second <= 100.0) {
+            values[filled++] = second;
+        }
+    }
+}
+
+// mean and standard deviation of the completed grades passing the filter
+bool fitCompletedGrades(const AssessmentRange& assessments, int section, MonteCarlo::Distribution& fitted) {
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    int count = 0;
+    for (const AssessmentView& assessment : assessments) {
+        if (!assessment.getIsComplete() || (section != -1 && assessment.getIsTheory() != (section == 1))) {
+            continue;
+        }
+        sum += assessment.getGrade();
+        sumSquares += assessment.getGrade() * assessment.getGrade();
+        count++;
+    }
+    if (count == 0) {
+        return false;
+    }
+
+    fitted.mean = sum / count;
+    fitted.standardDeviation = count > 1 ? std::sqrt(std::max(0.0, (sumSquares - sum * fitted.mean) / (count - 1))) : 0.0;
+    return true;
+}
+
+}
+
+double SimulationResult::getPercentile(double percent) const {
+    if (trialCount == 0 || histogram.empty()) {
+        return 0.0;
+    }
+
+    // the rank-th trial in grade order, interpolated inside its bin
+    double rank = std::clamp(percent, 0.0, 100.0) / 100.0 * trialCount;
+    uint64_t seen = 0;
+    for (int bin = 0; bin < binCount; bin++) {
+        if (histogram[bin] == 0) {
+            continue;
+        }
+        if (seen + histogram[bin] >= rank) {
+            double within = (rank - seen) / histogram[bin];
+            double grade = (bin + within) / binsPerPercent;
+            return std::clamp(grade, minimum, maximum);
+        }
+        seen += histogram[bin];
+    }
+    return maximum;
+}
+
+uint64_t SimulationResult::countBetween(double lowGrade, double highGrade) const {
+    int lowBin = std::clamp(static_cast<int>(lowGrade * binsPerPercent), 0, binCount);
+    int highBin = std::clamp(static_cast<int>(highGrade * binsPerPercent), 0, binCount);
+    uint64_t count = 0;
+    for (int bin = lowBin; bin < highBin; bin++) {
+        count += histogram[bin];
+    }
+    return count;
+}
+
+MonteCarlo::MonteCarlo(const Course& course) {
+    AssessmentRange assessments = course.getAssessments();
+
+    // fall back from the section's completed grades, to the course's, to a prior
+    Distribution courseFit{defaultMean, defaultStandardDeviation};
+    fitCompletedGrades(assessments, -1, courseFit);
+    Distribution sectionFits[2] = {courseFit, courseFit};
+    fitCompletedGrades(assessments, 0, sectionFits[0]);
+    fitCompletedGrades(assessments, 1, sectionFits[1]);
+
+    for (int i = 0; i < static_cast<int>(assessments.size()); i++) {
+        AssessmentView assessment = assessments[i];
+        if (assessment.getIsComplete()) {
+            baseGrade += assessment.getWeight() * assessment.getGrade() / 100;
+        } else {
+            incompleteIndices.push_back(i);
+            coefficients.push_back(assessment.getWeight() / 100);
+            distributions.push_back(sectionFits[assessment.getIsTheory() ? 1 : 0]);
+            setDistribution(static_cast<int>(distributions.size()) - 1, distributions.back());
+        }
+    }
+}
+
+//getter
+int MonteCarlo::getIncompleteCount() const {
+    return incompleteIndices.size();
+}
+
+int MonteCarlo::getAssessmentIndex(int incomplete) const {
+    return incompleteIndices[incomplete];
+}
+
+MonteCarlo::Distribution MonteCarlo::getDistribution(int incomplete) const {
+    return distributions[incomplete];
+}
+
+uint64_t MonteCarlo::getTrialCount() const {
+    return trialCount;
+}
+
+//setter
+void MonteCarlo::setDistribution(int incomplete, Distribution distribution) {
+    // keep the mean inside the truncation range so rejection sampling terminates quickly
+    distribution.mean = std::clamp(distribution.mean, 0.0, 100.0);
+    distribution.standardDeviation = std::max(distribution.standardDeviation, minimumStandardDeviation);
+    distributions[incomplete] = distribution;
+}
+
+void MonteCarlo::setTrialCount(uint64_t newTrialCount) {
+    trialCount = newTrialCount;
+}
+
+void MonteCarlo::setThreadCount(unsigned newThreadCount) {
+    threadCount = newThreadCount;
+}
+
+void MonteCarlo::setPassGrade(double newPassGrade) {
+    passGrade = newPassGrade;
+}
+
+void MonteCarlo::setGoalGrade(double newGoalGrade) {
+    goalGrade = newGoalGrade;
+}
+
+void MonteCarlo::setSeed(uint64_t newSeed) {
+    seed = newSeed;
+}
+
+void MonteCarlo::simulateBlock(uint64_t block, uint64_t trials, std::vector<uint64_t>& histogram,
+                               BlockTotals& totals, double& minimum, double& maximum,
+                               uint64_t& passCount, uint64_t& goalCount) const {
+    Xoshiro256 random(seed ^ (block * 0xd1342543de82ef95ULL));
+    double finals[batchSize];
+    double samples[batchSize];
+
+    for (uint64_t done = 0; done < trials; done += batchSize) {
+        int count = static_cast<int>(std::min<uint64_t>(batchSize, trials - done));
+
+        // one assessment at a time across the whole batch: the accumulation is a
+        // plain multiply-add over contiguous arrays, which the compiler vectorises
+        std::fill(finals, finals + count, baseGrade);
+        for (size_t i = 0; i < coefficients.size(); i++) {
+            sampleTruncatedNormal(random, distributions[i], samples, count);
+            double coefficient = coefficients[i];
+            for (int t = 0; t < count; t++) {
+                finals[t] += coefficient * samples[t];
+            }
+        }
+
+        for (int t = 0; t < count; t++) {
+            double grade = finals[t];
+            totals.sum += grade;
+            totals.sumSquares += grade * grade;
+            minimum = std::min(minimum, grade);
+            maximum = std::max(maximum, grade);
+            passCount += grade >= passGrade;
+            goalCount += grade >= goalGrade;
+            int bin = static_cast<int>(grade * SimulationResult::binsPerPercent);
+            histogram[std::clamp(bin, 0, SimulationResult::binCount - 1)]++;
+        }
+    }
+}
+
+SimulationResult MonteCarlo::run() const {
+    SimulationResult result;
+    result.trialCount = trialCount;
+    result.histogram.assign(SimulationResult::binCount, 0);
+    if (trialCount == 0) {
+        return result;
+    }
+
+    uint64_t blockCount = (trialCount + trialsPerBlock - 1) / trialsPerBlock;
+    unsigned threads = threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<uint64_t>(threads, blockCount));
+
+    // per-thread histograms and counts (integers, so merge order is irrelevant) and
+    // per-block sums, merged in block order so the mean is reproducible too
+    struct ThreadTotals {
+        std::vector<uint64_t> histogram;
+        double minimum = std::numeric_limits<double>::max();
+        double maximum = std::numeric_limits<double>::lowest();
+        uint64_t passCount = 0;
+        uint64_t goalCount = 0;
+    };
+    std::vector<ThreadTotals> threadTotals(threads);
+    std::vector<BlockTotals> blockTotals(blockCount);
+    std::atomic<uint64_t> nextBlock(0);
+
+    auto worker = [&](unsigned thread) {
+        ThreadTotals& mine = threadTotals[thread];
+        mine.histogram.assign(SimulationResult::binCount, 0);
+        for (uint64_t block = nextBlock++; block < blockCount; block = nextBlock++) {
+            uint64_t trials = std::min(trialsPerBlock, trialCount - block * trialsPerBlock);
+            simulateBlock(block, trials, mine.histogram, blockTotals[block],
+                          mine.minimum, mine.maximum, mine.passCount, mine.goalCount);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) {
+        workers.emplace_back(worker, t);
+    }
+    worker(0);
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    result.minimum = std::numeric_limits<double>::max();
+    result.maximum = std::numeric_limits<double>::lowest();
+    uint64_t passCount = 0;
+    uint64_t goalCount = 0;
+    for (const ThreadTotals& totals : threadTotals) {
+        for (int bin = 0; bin < SimulationResult::binCount; bin++) {
+            result.histogram[bin] += totals.histogram[bin];
+        }
+        result.minimum = std::min(result.minimum, totals.minimum);
+        result.maximum = std::max(result.maximum, totals.maximum);
+        passCount += totals.passCount;
+        goalCount += totals.goalCount;
+    }
+
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    for (const BlockTotals& totals : blockTotals) {
+        sum += totals.sum;
+        sumSquares += totals.sumSquares;
+    }
+    result.mean = sum / trialCount;
+    result.standardDeviation = std::sqrt(std::max(0.0, sumSquares / trialCount - result.mean * result.mean));
+    result.passProbability = static_cast<double>(passCount) / trialCount;
+    result.goalProbability = static_cast<double>(goalCount) / trialCount;
+    return result;
+}
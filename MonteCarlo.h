@@ -0,0 +1,87 @@
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include <cstdint>
+#include <vector>
+#include "Course.h"
+
+// Final-grade distribution produced by MonteCarlo::run.
+struct SimulationResult {
+    static constexpr int binsPerPercent = 100; // histogram resolution, 0.01%
+    static constexpr int binCount = 100 * binsPerPercent;
+
+    uint64_t trialCount = 0;
+    double mean = 0.0;
+    double standardDeviation = 0.0;
+    double minimum = 0.0;
+    double maximum = 0.0;
+    double passProbability = 0.0;  // share of trials at or above the pass grade
+    double goalProbability = 0.0;  // share of trials at or above the goal grade
+    std::vector<uint64_t> histogram; // final grades in [0, 100], binCount bins
+
+    double getPercentile(double percent) const; // e.g. 50 for the median
+    uint64_t countBetween(double lowGrade, double highGrade) const;
+};
+
+// Samples grades for every incomplete assessment of a course and collects the
+// resulting final grades (calculateOverallGrade(false) without the rounding).
+// Each incomplete assessment has its own truncated normal on [0, 100]; by default
+// it is fitted to the completed grades of the same section, then of the course.
+class MonteCarlo {
+public:
+    struct Distribution {
+        double mean;
+        double standardDeviation;
+    };
+
+private:
+    // final = baseGrade + sum(coefficients[i] * sampled grade i)
+    double baseGrade = 0.0;
+    std::vector<double> coefficients;
+    std::vector<int> incompleteIndices;
+    std::vector<Distribution> distributions;
+
+    uint64_t trialCount = 1000000;
+    unsigned threadCount = 0;
+    double passGrade = 50.0;
+    double goalGrade = 50.0;
+    uint64_t seed = 0x5eed5eed5eed5eedULL;
+
+    static constexpr double defaultMean = 70.0;
+    static constexpr double defaultStandardDeviation = 12.0;
+    static constexpr double minimumStandardDeviation = 5.0;
+
+    // Trials run in fixed-size blocks, each with its own generator seeded from the
+    // block number, so the result doesn't depend on which thread ran which block.
+    static constexpr uint64_t trialsPerBlock = 65536;
+    static constexpr int batchSize = 256; // trials sampled together, see simulateBlock
+
+    struct BlockTotals {
+        double sum = 0.0;
+        double sumSquares = 0.0;
+    };
+    void simulateBlock(uint64_t block, uint64_t trials, std::vector<uint64_t>& histogram,
+                       BlockTotals& totals, double& minimum, double& maximum,
+                       uint64_t& passCount, uint64_t& goalCount) const;
+
+public:
+    explicit MonteCarlo(const Course& course);
+
+    //getter
+    int getIncompleteCount() const;
+    int getAssessmentIndex(int incomplete) const; // position in the course
+    Distribution getDistribution(int incomplete) const;
+    uint64_t getTrialCount() const;
+
+    //setter
+    void setDistribution(int incomplete, Distribution distribution);
+    void setTrialCount(uint64_t newTrialCount);
+    void setThreadCount(unsigned newThreadCount); // 0 = one per core
+    void setPassGrade(double newPassGrade);
+    void setGoalGrade(double newGoalGrade);
+    void setSeed(uint64_t newSeed); // same seed and trial count: same result on any thread count
+
+    SimulationResult run() const;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#include "NameTable.h"
+#include <stdexcept>
+
+NameTable::NameTable() : chunks(new std::atomic<std::string*>[maxChunks]) {
+    for (uint32_t i = 0; i < maxChunks; i++) {
+        chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+    intern("");
+}
+
+NameTable::~NameTable() {
+    for (uint32_t i = 0; i < maxChunks; i++) {
+        delete[] chunks[i].load(std::memory_order_relaxed);
+    }
+}
+
+NameTable& NameTable::getShared() {
+    static NameTable table;
+    return table;
+}
+
+bool NameTable::find(std::string_view name, uint32_t& id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto found = ids.find(name);
+    if (found == ids.end()) {
+        return false;
+    }
+    id = found->second;
+    return true;
+}
+
+uint32_t NameTable::intern(std::string_view name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto found = ids.find(name);
+        if (found != ids.end()) {
+            return found->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto found = ids.find(name); // another thread may have added it meanwhile
+    if (found != ids.end()) {
+        return found->second;
+    }
+
+    uint32_t id = count.load(std::memory_order_relaxed);
+    uint32_t chunk = id >> chunkBits;
+    if (chunk >= maxChunks) {
+        throw std::length_error("Name table is full");
+    }
+    std::string* slots = chunks[chunk].load(std::memory_order_relaxed);
+    if (slots == nullptr) {
+        slots = new std::string[chunkSize];
+        chunks[chunk].store(slots, std::memory_order_release);
+    }
+
+    std::string& slot = slots[id & (chunkSize - 1)];
+    slot.assign(name.data(), name.size());
+    ids.emplace(std::string_view(slot), id);
+    count.store(id + 1, std::memory_order_release);
+    return id;
+}
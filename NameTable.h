@@ -0,0 +1,52 @@
+#ifndef NAME_TABLE_H
+#define NAME_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Process-wide interning table for assessment names. The same few names
+// ("Midterm", "Lab 1", "Final") repeat across every course, so each distinct
+// name is stored once and assessments keep a 32-bit id into this table.
+// Names are never removed: an id and the string_view it resolves to stay valid
+// for the life of the process. intern() is thread-safe, and getName() takes no
+// lock at all, since the strings live in fixed-size chunks that never move.
+class NameTable {
+private:
+    static const uint32_t chunkBits = 12;
+    static const uint32_t chunkSize = 1u << chunkBits;
+    static const uint32_t maxChunks = 1u << 16;
+
+    std::unique_ptr<std::atomic<std::string*>[]> chunks;
+    std::unordered_map<std::string_view, uint32_t> ids; // views into the chunks
+    std::atomic<uint32_t> count{0};
+    mutable std::shared_mutex mutex;
+
+public:
+    NameTable();
+    ~NameTable();
+    NameTable(const NameTable&) = delete;
+    NameTable& operator=(const NameTable&) = delete;
+
+    // the table every Assessment and AssessmentStore interns into
+    static NameTable& getShared();
+
+    // id of name, adding it on first sight; id 0 is always the empty name
+    uint32_t intern(std::string_view name);
+    // id of name without adding it; false if it was never interned
+    bool find(std::string_view name, uint32_t& id) const;
+
+    std::string_view getName(uint32_t id) const {
+        return chunks[id >> chunkBits].load(std::memory_order_acquire)[id & (chunkSize - 1)];
+    }
+
+    size_t getCount() const { return count.load(std::memory_order_acquire); }
+};
+
+#endif
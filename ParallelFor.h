@@ -0,0 +1,42 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Run work(i) for every i in [0, itemCount) on threadCount threads (0 = one per
+// core), the calling thread included. Threads claim chunkSize items at a time
+// from a shared counter, so a few expensive items don't leave the others idle.
+// work must be safe to call concurrently for different i.
+template<typename Work>
+void parallelFor(size_t itemCount, size_t chunkSize, unsigned threadCount, const Work& work) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t chunkCount = (itemCount + chunkSize - 1) / chunkSize;
+    threadCount = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threadCount, chunkCount)));
+
+    std::atomic<size_t> nextChunk(0);
+    auto worker = [&nextChunk, &work, itemCount, chunkSize]() {
+        for (size_t start = nextChunk.fetch_add(chunkSize); start < itemCount; start = nextChunk.fetch_add(chunkSize)) {
+            size_t end = std::min(start + chunkSize, itemCount);
+            for (size_t i = start; i < end; i++) {
+                work(i);
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threadCount; t++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+}
+
+#endif
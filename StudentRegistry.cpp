@@ -0,0 +1,149 @@
+#include "StudentRegistry.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+bool StudentRegistry::loadDirectory(const std::string& directoryPath, unsigned threadCount) {
+    namespace fs = std::filesystem;
+
+    std::vector<fs::path> files;
+    std::error_code error;
+    for (fs::directory_iterator entry(directoryPath, error), end; !error && entry != end; entry.increment(error)) {
+        if (entry->path().extension() == ".json" && entry->is_regular_file()) {
+            files.push_back(entry->path());
+        }
+    }
+    if (error) {
+        std::cerr << "Error: could not read student directory " << directoryPath << ": " << error.message() << std::endl;
+        return false;
+    }
+    std::sort(files.begin(), files.end(), [](const fs::path& a, const fs::path& b) {
+        return a.stem().string() < b.stem().string();
+    });
+
+    // Each student is loaded the way CourseManager loads its own file: the newer
+    // of snapshot and JSON, then the journal on top, read-only so nothing is
+    // trimmed or created. One file per claim into its own slot, they can be large.
+    std::vector<std::vector<Course>> parsed(files.size());
+    std::vector<std::string> errors(files.size());
+    parallelFor(files.size(), 1, threadCount, [&files, &parsed, &errors](size_t i) {
+        try {
+            CourseManager manager(files[i].string(), true);
+            if (!manager.isLoaded()) {
+                errors[i] = "could not load courses";
+                return;
+            }
+            uint64_t revision;
+            parsed[i] = manager.getCoursesSnapshot(revision);
+        } catch (const std::exception& e) {
+            errors[i] = e.what();
+            parsed[i].clear();
+        }
+    });
+
+    size_t total = courses.size();
+    for (const std::vector<Course>& studentCourses : parsed) {
+        total += studentCourses.size();
+    }
+    courses.reserve(total);
+
+    bool allLoaded = true;
+    for (size_t i = 0; i < files.size(); i++) {
+        if (!errors[i].empty()) {
+            std::cerr << "Error loading " << files[i].string() << ": " << errors[i] << std::endl;
+            allLoaded = false;
+        } else if (!addStudent(files[i].stem().string(), std::move(parsed[i]))) {
+            allLoaded = false;
+        }
+    }
+    return allLoaded;
+}
+
+bool StudentRegistry::addStudent(const std::string& studentId, std::vector<Course> studentCourses) {
+    int student = getStudentCount();
+    if (!studentIndex.emplace(studentId, student).second) {
+        std::cerr << "Error: student " << studentId << " is already registered" << std::endl;
+        return false;
+    }
+    studentIds.push_back(studentId);
+
+    for (Course& course : studentCourses) {
+        courseCodeIndex[course.getCourseCode()].push_back(getCourseCount());
+        courses.push_back(std::move(course));
+    }
+    firstCourse.push_back(getCourseCount());
+    return true;
+}
+
+void StudentRegistry::clear() {
+    courses.clear();
+    studentIds.clear();
+    firstCourse.assign(1, 0);
+    studentIndex.clear();
+    courseCodeIndex.clear();
+}
+
+int StudentRegistry::getStudentCount() const { return static_cast<int>(studentIds.size()); }
+int StudentRegistry::getCourseCount() const { return static_cast<int>(courses.size()); }
+const std::string& StudentRegistry::getStudentId(int student) const { return studentIds.at(student); }
+int StudentRegistry::getFirstCourse(int student) const { return firstCourse.at(student); }
+const Course& StudentRegistry::getCourse(int course) const { return courses.at(course); }
+
+int StudentRegistry::getStudentCourseCount(int student) const {
+    return firstCourse.at(student + 1) - firstCourse.at(student);
+}
+
+int StudentRegistry::getStudentOfCourse(int course) const {
+    if (course < 0 || course >= getCourseCount()) {
+        return -1;
+    }
+    // the last student whose first course is at or before this one
+    auto owner = std::upper_bound(firstCourse.begin(), firstCourse.end() - 1, course);
+    return static_cast<int>(owner - firstCourse.begin()) - 1;
+}
+
+int StudentRegistry::findStudent(const std::string& studentId) const {
+    auto found = studentIndex.find(studentId);
+    return found != studentIndex.end() ? found->second : -1;
+}
+
+const Course* StudentRegistry::findCourse(const std::string& studentId, const std::string& courseCode) const {
+    int student = findStudent(studentId);
+    if (student < 0) {
+        return nullptr;
+    }
+    for (int i = firstCourse[student]; i < firstCourse[student + 1]; i++) {
+        if (courses[i].getCourseCode() == courseCode) {
+            return &courses[i];
+        }
+    }
+    return nullptr;
+}
+
+const std::vector<int>& StudentRegistry::getCoursesWithCode(const std::string& courseCode) const {
+    static const std::vector<int> none;
+    auto found = courseCodeIndex.find(courseCode);
+    return found != courseCodeIndex.end() ? found->second : none;
+}
+
+std::vector<CourseEvaluation> StudentRegistry::evaluateAll(double goal, unsigned threadCount) const {
+    std::vector<CourseEvaluation> results(courses.size());
+    // each thread writes only the result slots of the courses it claimed
+    parallelFor(courses.size(), 64, threadCount, [this, goal, &results](size_t i) {
+        CourseEvaluation& result = results[i];
+        result.summary = courses[i].calculateSummary(true);
+        result.requiredGrade = courses[i].calculateRequiredUniformGrade(goal, result.isGoalAchievable);
+    });
+    return results;
+}
+
+RequiredGradeMatrix StudentRegistry::calculateRequiredGradeMatrix(const std::vector<double>& goals,
+                                                                 unsigned threadCount) const {
+    RequiredGradeMatrix matrix(goals, getCourseCount());
+    parallelFor(courses.size(), 64, threadCount, [this, &matrix](size_t i) {
+        int row = static_cast<int>(i);
+        courses[i].calculateRequiredUniformGrades(matrix.goals, matrix.getRow(row), matrix.getAchievableRow(row));
+    });
+    return matrix;
+}
@@ -0,0 +1,59 @@
+#ifndef STUDENT_REGISTRY_H
+#define STUDENT_REGISTRY_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Course.h"
+#include "CourseManager.h"
+
+// Read-only course sets of many students in one process. Every student's courses
+// sit in one contiguous vector, student after student, so cohort-wide passes walk
+// a single array; lookups go through indexes by student id and by course code.
+// Students are added whole and never edited here; CourseManager stays the owner
+// of a single student's file, journal and snapshot.
+class StudentRegistry {
+private:
+    std::vector<Course> courses;
+    std::vector<std::string> studentIds;
+    std::vector<int> firstCourse{0}; // student s owns courses [firstCourse[s], firstCourse[s + 1])
+    std::unordered_map<std::string, int> studentIndex;
+    std::unordered_map<std::string, std::vector<int>> courseCodeIndex;
+
+public:
+    StudentRegistry() = default;
+
+    // Load every *.json file in a directory as one student, the file name without
+    // the extension being the student id. Each goes through a read-only
+    // CourseManager, so a newer snapshot and edits still in the journal count.
+    // Students are loaded in parallel and added in id order. Files that fail to
+    // load are reported and skipped; returns false if the directory can't be
+    // read or any file was skipped.
+    bool loadDirectory(const std::string& directoryPath, unsigned threadCount = 0);
+
+    // false (and nothing added) if the id is already registered
+    bool addStudent(const std::string& studentId, std::vector<Course> studentCourses);
+    void clear();
+
+    //getter
+    int getStudentCount() const;
+    int getCourseCount() const;
+    const std::string& getStudentId(int student) const;
+    int getFirstCourse(int student) const;
+    int getStudentCourseCount(int student) const;
+    int getStudentOfCourse(int course) const;
+    const Course& getCourse(int course) const;
+    const std::vector<Course>& getAllCourses() const { return courses; }
+
+    // -1 / nullptr / empty when nothing matches
+    int findStudent(const std::string& studentId) const;
+    const Course* findCourse(const std::string& studentId, const std::string& courseCode) const;
+    const std::vector<int>& getCoursesWithCode(const std::string& courseCode) const;
+
+    // CourseManager::evaluateAll over every course of every student, indexed like getCourse
+    std::vector<CourseEvaluation> evaluateAll(double goal, unsigned threadCount = 0) const;
+    // and CourseManager::calculateRequiredGradeMatrix, one row per course
+    RequiredGradeMatrix calculateRequiredGradeMatrix(const std::vector<double>& goals, unsigned threadCount = 0) const;
+};
+
+#endif
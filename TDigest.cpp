@@ -0,0 +1,217 @@
+#include "TDigest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+const size_t centroidSize = 2 * sizeof(double);
+
+template<typename T>
+void appendValue(std::string& buffer, T value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+bool readValue(std::string_view& bytes, T& value) {
+    if (bytes.size() < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, bytes.data(), sizeof(T));
+    bytes.remove_prefix(sizeof(T));
+    return true;
+}
+
+} // namespace
+
+TDigest::TDigest(double compression) : compression(std::max(compression, 10.0)) {}
+
+// adds are buffered and sorted in together, which is much cheaper than inserting
+size_t TDigest::getBufferLimit() const {
+    return static_cast<size_t>(compression) * 5;
+}
+
+void TDigest::add(double value, double weight) {
+    if (weight <= 0.0) {
+        return;
+    }
+    if (totalWeight == 0.0) {
+        minimum = value;
+        maximum = value;
+    } else {
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+    }
+    buffer.push_back({value, weight});
+    totalWeight += weight;
+    if (buffer.size() >= getBufferLimit()) {
+        compress();
+    }
+}
+
+void TDigest::merge(const TDigest& other) {
+    if (other.totalWeight == 0.0) {
+        return;
+    }
+    if (totalWeight == 0.0) {
+        minimum = other.minimum;
+        maximum = other.maximum;
+    } else {
+        minimum = std::min(minimum, other.minimum);
+        maximum = std::max(maximum, other.maximum);
+    }
+    buffer.insert(buffer.end(), other.centroids.begin(), other.centroids.end());
+    buffer.insert(buffer.end(), other.buffer.begin(), other.buffer.end());
+    totalWeight += other.totalWeight;
+    if (buffer.size() >= getBufferLimit()) {
+        compress();
+    }
+}
+
+void TDigest::compress() {
+    if (buffer.empty()) {
+        return;
+    }
+    std::vector<Centroid> merged;
+    compressInto(merged);
+    centroids.swap(merged);
+    buffer.clear();
+}
+
+// One left-to-right pass over everything sorted by mean. A centroid keeps absorbing
+// its neighbours while it spans at most one unit of the scale function
+// k(q) = compression / (2 pi) * asin(2q - 1), which is steep near q = 0 and q = 1.
+void TDigest::compressInto(std::vector<Centroid>& merged) const {
+    std::vector<Centroid> all;
+    all.reserve(centroids.size() + buffer.size());
+    all.insert(all.end(), centroids.begin(), centroids.end());
+    all.insert(all.end(), buffer.begin(), buffer.end());
+    std::stable_sort(all.begin(), all.end(), [](const Centroid& a, const Centroid& b) {
+        return a.mean < b.mean;
+    });
+
+    merged.clear();
+    if (all.empty()) {
+        return;
+    }
+
+    double normaliser = compression / (2.0 * pi);
+    double maximumK = normaliser * pi / 2.0;
+    auto qLimitAfter = [normaliser, maximumK](double q) {
+        double k = std::min(normaliser * std::asin(2.0 * q - 1.0) + 1.0, maximumK);
+        return (std::sin(k / normaliser) + 1.0) / 2.0;
+    };
+
+    Centroid current = all[0];
+    double weightSoFar = 0.0;
+    double qLimit = qLimitAfter(0.0);
+    for (size_t i = 1; i < all.size(); i++) {
+        const Centroid& next = all[i];
+        double proposed = (weightSoFar + current.weight + next.weight) / totalWeight;
+        if (proposed <= qLimit) {
+            current.weight += next.weight;
+            current.mean += (next.mean - current.mean) * next.weight / current.weight;
+        } else {
+            merged.push_back(current);
+            weightSoFar += current.weight;
+            qLimit = qLimitAfter(std::min(weightSoFar / totalWeight, 1.0));
+            current = next;
+        }
+    }
+    merged.push_back(current);
+}
+
+// Interpolates between centroid centres, and between the outer centres and the
+// exact minimum and maximum at the ends.
+double TDigest::getQuantile(double q) const {
+    if (totalWeight == 0.0) {
+        return 0.0;
+    }
+
+    std::vector<Centroid> merged;
+    if (!buffer.empty()) {
+        compressInto(merged);
+    }
+    const std::vector<Centroid>& sorted = buffer.empty() ? centroids : merged;
+    if (sorted.size() == 1) {
+        return sorted[0].mean;
+    }
+
+    double index = std::min(std::max(q, 0.0), 1.0) * totalWeight;
+
+    const Centroid& first = sorted.front();
+    if (index <= first.weight / 2.0) {
+        return minimum + (first.mean - minimum) * index / (first.weight / 2.0);
+    }
+    const Centroid& last = sorted.back();
+    if (index >= totalWeight - last.weight / 2.0) {
+        return maximum - (maximum - last.mean) * (totalWeight - index) / (last.weight / 2.0);
+    }
+
+    double centre = first.weight / 2.0;
+    for (size_t i = 0; i + 1 < sorted.size(); i++) {
+        double gap = (sorted[i].weight + sorted[i + 1].weight) / 2.0;
+        if (index <= centre + gap) {
+            double t = (index - centre) / gap;
+            return sorted[i].mean + t * (sorted[i + 1].mean - sorted[i].mean);
+        }
+        centre += gap;
+    }
+    return last.mean;
+}
+
+// Serialisation
+void TDigest::serialize(std::string& bytes) const {
+    std::vector<Centroid> merged;
+    if (!buffer.empty()) {
+        compressInto(merged);
+    }
+    const std::vector<Centroid>& sorted = buffer.empty() ? centroids : merged;
+
+    appendValue<double>(bytes, compression);
+    appendValue<double>(bytes, minimum);
+    appendValue<double>(bytes, maximum);
+    appendValue<uint32_t>(bytes, static_cast<uint32_t>(sorted.size()));
+    for (const Centroid& centroid : sorted) {
+        appendValue<double>(bytes, centroid.mean);
+        appendValue<double>(bytes, centroid.weight);
+    }
+}
+
+bool TDigest::deserialize(std::string_view& bytes) {
+    std::string_view input = bytes;
+    double storedCompression, storedMinimum, storedMaximum;
+    uint32_t count;
+    if (!readValue(input, storedCompression) || !readValue(input, storedMinimum) ||
+        !readValue(input, storedMaximum) || !readValue(input, count) || count > input.size() / centroidSize ||
+        !(storedCompression >= 10.0) || (count > 0 && !(storedMinimum <= storedMaximum))) {
+        return false;
+    }
+
+    // the total is summed rather than stored, so it always matches the centroids
+    std::vector<Centroid> stored(count);
+    double storedWeight = 0.0;
+    for (Centroid& centroid : stored) {
+        readValue(input, centroid.mean);
+        readValue(input, centroid.weight);
+        if (!(centroid.weight > 0.0) || !std::isfinite(centroid.weight) || !std::isfinite(centroid.mean)) {
+            return false;
+        }
+        storedWeight += centroid.weight;
+    }
+    // queries walk the centroids in order, whatever order a corrupt file has
+    std::stable_sort(stored.begin(), stored.end(), [](const Centroid& a, const Centroid& b) {
+        return a.mean < b.mean;
+    });
+
+    compression = storedCompression;
+    centroids = std::move(stored);
+    buffer.clear();
+    totalWeight = storedWeight;
+    minimum = count > 0 ? storedMinimum : 0.0;
+    maximum = count > 0 ? storedMaximum : 0.0;
+    bytes = input;
+    return true;
+}
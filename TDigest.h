@@ -0,0 +1,55 @@
+#ifndef TDIGEST_H
+#define TDIGEST_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Mergeable quantile sketch (Dunning's merging t-digest). Values are kept as
+// weighted centroids that are small near the tails and large in the middle, so
+// extreme quantiles stay accurate in a fixed amount of memory. Two digests built
+// over separate shards merge into one as if all values had been added to it.
+class TDigest {
+public:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+private:
+    double compression;
+    std::vector<Centroid> centroids;        // sorted by mean after compress()
+    std::vector<Centroid> buffer;           // added since the last compress()
+    double totalWeight = 0.0;
+    double minimum = 0.0;
+    double maximum = 0.0;
+
+    size_t getBufferLimit() const;
+    void compressInto(std::vector<Centroid>& merged) const;
+
+public:
+    // compression bounds the centroid count (about compression / 2 after a compress)
+    explicit TDigest(double compression = 100.0);
+
+    void add(double value, double weight = 1.0);
+    void merge(const TDigest& other);
+    void compress(); // fold the buffer in; queries on an uncompressed digest work on a copy
+
+    // Binary form for merging digests built in another process: the compression,
+    // the bounds and the centroids with the buffer folded in. deserialize reads
+    // one digest from the front of bytes and moves past it; false (digest
+    // unchanged) if it is truncated or inconsistent.
+    void serialize(std::string& bytes) const;
+    bool deserialize(std::string_view& bytes);
+
+    //getter
+    double getCount() const { return totalWeight; }
+    double getMinimum() const { return minimum; }
+    double getMaximum() const { return maximum; }
+    // q in [0, 1]; 0 when nothing was added
+    double getQuantile(double q) const;
+    const std::vector<Centroid>& getCentroids() const { return centroids; } // as of the last compress()
+};
+
+#endif
@@ -0,0 +1,96 @@
+#include "TableRenderer.h"
+#include <charconv>
+#include <limits>
+
+TableRenderer::TableRenderer(std::vector<Column> columns, size_t expectedRows) : columns(std::move(columns)) {
+    totalWidth = 4; // "| " and " |"
+    for (size_t i = 0; i < this->columns.size(); i++) {
+        totalWidth += this->columns[i].width + (i > 0 ? 3 : 0); // " | " between columns
+    }
+    buffer.reserve((totalWidth + 1) * (expectedRows + 4));
+}
+
+void TableRenderer::pad(std::string_view text, int width, Align align) {
+    int padding = width - static_cast<int>(text.size());
+    if (padding > 0 && align == Align::Right) {
+        buffer.append(padding, ' ');
+    }
+    buffer.append(text);
+    if (padding > 0 && align == Align::Left) {
+        buffer.append(padding, ' ');
+    }
+}
+
+void TableRenderer::addRule() {
+    buffer.append(totalWidth, '-');
+    buffer += '\n';
+}
+
+void TableRenderer::addLine(std::string_view text) {
+    buffer.append(text);
+    buffer += '\n';
+}
+
+void TableRenderer::addSpanningRow(std::string_view text) {
+    buffer += "| ";
+    pad(text, totalWidth - 4, Align::Left);
+    buffer += " |\n";
+}
+
+void TableRenderer::addCell(std::string_view text) {
+    buffer += currentColumn == 0 ? "| " : " | ";
+    const Column& column = columns[currentColumn];
+    pad(text, column.width, column.align);
+
+    if (++currentColumn == columns.size()) {
+        buffer += " |\n";
+        currentColumn = 0;
+    }
+}
+
+void TableRenderer::addCell(int value) {
+    char digits[16];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    addCell(std::string_view(digits, result.ptr - digits));
+}
+
+void TableRenderer::addCell(double value, int precision, std::string_view suffix) {
+    // through appendNumber, so a value too wide for its buffer still shows in full
+    std::string cell;
+    appendNumber(cell, value, precision);
+    cell += suffix;
+    addCell(cell);
+}
+
+void TableRenderer::writeTo(std::ostream& out) const {
+    out.write(buffer.data(), buffer.size());
+}
+
+void TableRenderer::clear() {
+    buffer.clear();
+    currentColumn = 0;
+}
+
+void TableRenderer::appendNumber(std::string& target, double value, int precision) {
+    char text[64];
+    std::to_chars_result result = std::to_chars(text, text + sizeof(text), value, std::chars_format::fixed, precision);
+    if (result.ec == std::errc()) {
+        target.append(text, result.ptr - text);
+        return;
+    }
+
+    // only huge magnitudes get here: fixed notation of DBL_MAX runs to 309 digits
+    std::string wide(std::numeric_limits<double>::max_exponent10 + precision + 4, '\0');
+    result = std::to_chars(wide.data(), wide.data() + wide.size(), value, std::chars_format::fixed, precision);
+    if (result.ec == std::errc()) {
+        target.append(wide.data(), result.ptr - wide.data());
+    } else {
+        target += std::to_string(value); // never leave the cell empty
+    }
+}
+
+std::string TableRenderer::formatNumber(double value, int precision) {
+    std::string text;
+    appendNumber(text, value, precision);
+    return text;
+}
@@ -0,0 +1,53 @@
+#ifndef TABLE_RENDERER_H
+#define TABLE_RENDERER_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Builds a fixed-width text table into one preallocated buffer and emits it with a
+// single write. Rows look like "| a   | b        |   c |"; numbers are formatted
+// with std::to_chars instead of stream manipulators.
+class TableRenderer {
+public:
+    enum class Align { Left, Right };
+
+    struct Column {
+        int width;
+        Align align;
+    };
+
+private:
+    std::vector<Column> columns;
+    std::string buffer;
+    size_t currentColumn = 0;
+    int totalWidth;
+
+    void pad(std::string_view text, int width, Align align);
+
+public:
+    explicit TableRenderer(std::vector<Column> columns, size_t expectedRows = 16);
+
+    int getTotalWidth() const { return totalWidth; }
+
+    void addRule();                                  // ------- across the table
+    void addLine(std::string_view text);             // raw text plus newline
+    void addSpanningRow(std::string_view text);      // "| text ... |" across the table
+
+    // cells are filled left to right; the row closes after the last column
+    void addCell(std::string_view text);
+    void addCell(int value);
+    void addCell(double value, int precision, std::string_view suffix = "");
+
+    const std::string& getBuffer() const { return buffer; }
+    void writeTo(std::ostream& out) const;
+    void clear();
+
+    // fixed-point formatting shared with other bulk output paths
+    static void appendNumber(std::string& target, double value, int precision);
+    static std::string formatNumber(double value, int precision);
+};
+
+#endif
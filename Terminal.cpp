@@ -0,0 +1,122 @@
+#include "Terminal.h"
+#include <cstdlib>
+#include <iostream>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/ioctl.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+const char* const clearSequence = "\x1b[H\x1b[2J\x1b[3J"; // home, clear screen, clear scrollback
+const char* const clearLineTail = "\x1b[K";
+const char* const clearBelow = "\x1b[J";
+
+std::string moveTo(size_t row) {
+    return "\x1b[" + std::to_string(row + 1) + ";1H";
+}
+
+std::vector<std::string> splitLines(const std::string& frame) {
+    std::vector<std::string> lines;
+    size_t start = 0;
+    while (start < frame.size()) {
+        size_t end = frame.find('\n', start);
+        if (end == std::string::npos) {
+            lines.push_back(frame.substr(start));
+            break;
+        }
+        lines.push_back(frame.substr(start, end - start));
+        start = end + 1;
+    }
+    return lines;
+}
+
+} // namespace
+
+Terminal::Terminal() {
+    #ifdef _WIN32
+        // older consoles only understand escape sequences once asked to
+        HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        ansiAvailable = output != INVALID_HANDLE_VALUE && GetConsoleMode(output, &mode) &&
+                        SetConsoleMode(output, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    #else
+        ansiAvailable = true;
+    #endif
+}
+
+void Terminal::setDiffRedraw(bool enabled) {
+    diffRedraw = enabled && ansiAvailable;
+    hasPreviousFrame = false;
+}
+
+int Terminal::getScreenRows() const {
+    #ifdef _WIN32
+        CONSOLE_SCREEN_BUFFER_INFO info;
+        if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+            return info.srWindow.Bottom - info.srWindow.Top + 1;
+        }
+    #else
+        struct winsize size;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0) {
+            return size.ws_row;
+        }
+    #endif
+    return 24;
+}
+
+void Terminal::write(const std::string& buffer) const {
+    std::cout.write(buffer.data(), buffer.size());
+    std::cout.flush();
+}
+
+void Terminal::clear() {
+    hasPreviousFrame = false;
+
+    if (!ansiAvailable) {
+        #ifdef _WIN32
+            std::system("cls");
+        #endif
+        return;
+    }
+    write(clearSequence);
+}
+
+void Terminal::present(const std::string& frame) {
+    std::vector<std::string> lines = splitLines(frame);
+
+    // diffing addresses rows from the top, so it only holds while nothing scrolled;
+    // leave a few rows for the prompt and input under the frame
+    bool canDiff = diffRedraw && hasPreviousFrame && static_cast<int>(lines.size()) + 4 < getScreenRows();
+
+    if (!canDiff) {
+        clear();
+        write(frame);
+    } else {
+        std::string buffer;
+        buffer.reserve(frame.size() + lines.size() * 8);
+
+        for (size_t row = 0; row < lines.size(); row++) {
+            bool isLastPartial = row + 1 == lines.size() && !frame.empty() && frame.back() != '\n';
+            if (row < previousLines.size() && previousLines[row] == lines[row] && !isLastPartial) {
+                continue;
+            }
+            buffer += moveTo(row);
+            buffer += lines[row];
+            buffer += clearLineTail;
+        }
+
+        // park the cursor where a full redraw would have left it, then wipe the rest
+        if (frame.empty() || frame.back() == '\n') {
+            buffer += moveTo(lines.size());
+        }
+        buffer += clearBelow;
+        write(buffer);
+    }
+
+    previousLines = std::move(lines);
+    hasPreviousFrame = diffRedraw;
+}
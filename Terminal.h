@@ -0,0 +1,34 @@
+#ifndef TERMINAL_H
+#define TERMINAL_H
+
+#include <string>
+#include <vector>
+
+// In-process screen control with ANSI escape sequences, replacing the
+// system("clear")/system("cls") fork+exec on every redraw. Each call builds one
+// buffer and writes it to std::cout in a single write.
+//
+// With diff redraw on, present() compares the new frame with the last one line
+// by line and only rewrites the lines that changed, then clears whatever was
+// printed below the frame since (prompts, typed input, messages).
+class Terminal {
+private:
+    bool ansiAvailable;
+    bool diffRedraw = false;
+    bool hasPreviousFrame = false;
+    std::vector<std::string> previousLines;
+
+    int getScreenRows() const;
+    void write(const std::string& buffer) const;
+
+public:
+    Terminal();
+
+    void setDiffRedraw(bool enabled);
+    bool getDiffRedraw() const { return diffRedraw; }
+
+    void clear();                            // blank screen, forget the last frame
+    void present(const std::string& frame);  // show frame as the whole screen
+};
+
+#endif
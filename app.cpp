@@ -1,19 +1,33 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <iostream>
 #include <string>
 #include <vector>
 #include <iomanip>
 #include <sstream>
+#include <utility>
 #include "Course.h"
 #include "Assessment.h"
 #include "CourseManager.h"
+#include "Terminal.h"
+#include "TableRenderer.h"
+#include "MonteCarlo.h"
+#include "StudentRegistry.h"
+#include "CohortStatistics.h"
+#include "GradeScale.h"
+#include "GpaTracker.h"
+
+Terminal terminal;
 
 // clear console screen on whatever
 void clearScreen() {
-    #ifdef _WIN32
-        system("cls");
-    #else
-        system("clear");
-    #endif
+    terminal.clear();
+}
+
+// replace the whole screen with frame, redrawing only changed lines when enabled
+void showScreen(const std::string& frame) {
+    terminal.present(frame);
 }
 
 // Function to get user input with validation
@@ -43,13 +57,33 @@ std::string getStringInput(const std::string& prompt) {
     return value;
 }
 
+// Keep a hypothetical grade within 0-100%, saying so when it had to be moved
+double clampGrade(double grade, std::ostream& out) {
+    double clamped = std::min(std::max(grade, 0.0), 100.0);
+    if (clamped != grade) {
+        out << "Grade " << grade << "% is outside 0-100%, using " << clamped << "% instead.\n";
+    }
+    return clamped;
+}
+
 // Function to add a new course
 void addNewCourse(CourseManager& manager) {
     std::string courseCode = getStringInput("Enter course code: ");
+    if (manager.findCourse(courseCode) >= 0) {
+        std::cout << "Warning: a course with code " << courseCode << " already exists.\n";
+    }
     bool isA5050Course = getInput<char>("Is this a 50/50 course? (y/n): ") == 'y';
+    double credits = getInput<double>("Credits: ");
+    while (credits < 0) {
+        std::cout << "Credits can't be negative.\n";
+        credits = getInput<double>("Credits: ");
+    }
+    std::string term = getStringInput("Term (e.g. 2025-09, empty for none): ");
     
     // Create a new course with empty assessments list
     Course newCourse(courseCode, {}, isA5050Course);
+    newCourse.setCredits(credits);
+    newCourse.setTerm(term);
     
     // Ask user if they want to add assessments now
     if (getInput<char>("Add assessments now? (y/n): ") == 'y') {
@@ -103,179 +137,203 @@ void displayCourses(const CourseManager& manager) {
     std::cout << "\n=== Courses ===\n";
     for (int i = 0; i < courses.size(); i++) {
         const Course& course = courses[i];
+        GradeSummary summary = course.calculateSummary(true);
         std::cout << i + 1 << ". " << course.getCourseCode()
                   << " (Assessments: " << course.getAssessmentCount() << ")";
                   
         // If there are completed assessments, show current grade
-        if (course.getTotalWeight() == 100) {
-            std::cout << " - Completed -  Final Grade: " << course.calculateOverallGrade(true) << "%";
+        if (summary.isTotalWeightValid) {
+            std::cout << " - Completed -  Final Grade: " << summary.overallGrade << "%";
         } else {
-            std::cout << " -  Pending  - Grade so far: " << course.calculateGradeSoFar(true) << "%";
+            std::cout << " -  Pending  - Grade so far: " << summary.gradeSoFar << "%";
         }
         std::cout << std::endl;
     }
-}
 
-void viewAssessmentsDetails(Course& chosenCourse, const std::vector<Assessment>& assessments, bool careForComplete) {
-    bool is5050Course = chosenCourse.getIsA5050Course();
+    std::vector<std::string> duplicates = manager.getDuplicateCourseCodes();
+    if (!duplicates.empty()) {
+        std::cout << "\nWarning: more than one course uses the code";
+        for (const std::string& courseCode : duplicates) {
+            std::cout << ' ' << courseCode;
+        }
+        std::cout << std::endl;
+    }
+}
 
-    const int idWidth = 3;
-    const int nameWidth = 25;
-    const int weightWidth = 8;
-    const int gradeWidth = 8;
-    const int statusWidth = 10;
+// Term and cumulative GPA, read from the tracker's running totals
+void displayGpa(const GpaTracker& gpa) {
+    std::vector<TermGpa> terms = gpa.getTerms();
+    GpaTotals cumulative = gpa.getCumulative();
+    if (cumulative.courseCount == 0) {
+        std::cout << "\nGPA: no finished courses with credits yet" << std::endl;
+        return;
+    }
 
-    // Calculate total width for horizontal line
-    const int totalWidth = idWidth + 1 + nameWidth + 1 + weightWidth + 1 + gradeWidth + 1 + statusWidth + 12;
+    std::cout << std::fixed << std::setprecision(2) << "\n=== GPA ===\n";
+    for (const TermGpa& term : terms) {
+        std::cout << (term.term.empty() ? "(no term)" : term.term) << ": " << term.totals.getGpa()
+                  << " over " << term.totals.credits << " credits\n";
+    }
+    std::cout << "Cumulative: " << cumulative.getGpa() << " over " << cumulative.credits << " credits ("
+              << cumulative.courseCount << " courses)" << std::endl;
+    std::cout << std::defaultfloat;
+}
 
-    std::string horizontalLine(totalWidth, '-');
+// column layout shared by every assessment table
+TableRenderer makeAssessmentTable(size_t expectedRows) {
+    return TableRenderer({
+        {3, TableRenderer::Align::Left},   // #
+        {25, TableRenderer::Align::Left},  // name
+        {8, TableRenderer::Align::Right},  // weight
+        {8, TableRenderer::Align::Right},  // grade
+        {10, TableRenderer::Align::Left}   // status
+    }, expectedRows);
+}
 
-    std::cout << "\nAssessments:\n";
-    std::cout << horizontalLine << "\n";
+// header and rows for one section (theory or lab) of a course
+void renderAssessmentSection(TableRenderer& table, const Course& chosenCourse, bool isTheory, double sectionGrade) {
+    const int nameWidth = 25;
+    AssessmentRange assessments = chosenCourse.getAssessments();
 
-    // Header row
-    if (is5050Course) {
+    table.addCell("#");
+    if (chosenCourse.getIsA5050Course()) {
         // Display with section grade for 50/50 courses
-        double theoryGrade = chosenCourse.calculateSectionGradeSoFar(true, careForComplete);
-        std::cout << "| " << std::setw(idWidth) << std::left << "#"
-                  << " | " << std::setw(nameWidth-8) << std::left << "Theory" 
-                  << "(" << std::fixed << std::setprecision(2) << theoryGrade << "%)"
-                  << " | " << std::setw(weightWidth) << std::right << "Weight"
-                  << " | " << std::setw(gradeWidth) << std::right << "Grade"
-                  << " | " << std::setw(statusWidth) << std::left << "Status" << " |"
-                  << "\n";
+        std::string title = isTheory ? "Theory" : "Lab";
+        title.resize(nameWidth - 8, ' ');
+        title += '(';
+        TableRenderer::appendNumber(title, sectionGrade, 2);
+        title += "%)";
+        table.addCell(title);
     } else {
-        // Display without section grade for regular courses
-        std::cout << "| " << std::setw(idWidth) << std::left << "#"
-                  << " | " << std::setw(nameWidth) << std::left << "Theory" 
-                  << " | " << std::setw(weightWidth) << std::right << "Weight"
-                  << " | " << std::setw(gradeWidth) << std::right << "Grade"
-                  << " | " << std::setw(statusWidth) << std::left << "Status" << " |"
-                  << "\n";
+        table.addCell(isTheory ? "Theory" : "Lab");
     }
-    
-    std::cout << horizontalLine << "\n";
-    
-    // Data rows for theory section
+    table.addCell("Weight");
+    table.addCell("Grade");
+    table.addCell("Status");
+    table.addRule();
+
     for (int i = 0; i < chosenCourse.getAssessmentCount(); i++) {
-        const Assessment& assessment = assessments[i];
+        AssessmentView assessment = assessments[i];
+        if (assessment.getIsTheory() != isTheory) {
+            continue;
+        }
 
-        if (assessment.getIsTheory()) {
+        table.addCell(i + 1);
 
-            bool isComplete = assessment.getIsComplete();
-            double grade = assessment.getGrade();
-            
-            // Format ID column
-            std::cout << "| " << std::setw(idWidth) << std::left << (i + 1);
-            
-            // Format Name column
-            std::string name = assessment.getName();
-            if (name.length() > nameWidth) {
-                name = name.substr(0, nameWidth - 3) + "...";
-            }
-            std::cout << " | " << std::setw(nameWidth) << std::left << name;
-            
-            // Format Weight column
-            std::cout << " | " << std::setw(weightWidth - 1) << std::right << assessment.getWeight() << "%";
-            
-            // Format Grade column
-            if (grade != 0.0) {
-                std::cout << " | " << std::setw(gradeWidth - 1) << std::right << std::fixed << std::setprecision(2) << grade << "%";
-            } else {
-                std::cout << " | " << std::setw(gradeWidth) << std::right << "N/A";
-            }
-            
-            // Format Status column
-            std::cout << " | " << std::setw(statusWidth) << std::left 
-                    << (isComplete ? "Complete" : "Pending") << " |";
-            
-            std::cout << "\n";
+        std::string_view name = assessment.getName();
+        if (name.length() > nameWidth) {
+            table.addCell(std::string(name.substr(0, nameWidth - 3)) + "...");
+        } else {
+            table.addCell(name);
         }
-    }
-        
-        std::cout << horizontalLine << "\n";
-        // Header row
-        if (is5050Course) {
-            double labGrade = chosenCourse.calculateSectionGradeSoFar(false, careForComplete);
-            std::cout << "| " << std::setw(idWidth) << std::left << "#"
-                      << " | " << std::setw(nameWidth-8) << std::left << "Lab" 
-                      << "(" << std::fixed << std::setprecision(2) << labGrade << "%)"
-                      << " | " << std::setw(weightWidth) << std::right << "Weight"
-                      << " | " << std::setw(gradeWidth) << std::right << "Grade"
-                      << " | " << std::setw(statusWidth) << std::left << "Status" << " |"
-                      << "\n";
+
+        table.addCell(assessment.getWeight(), 2, "%");
+
+        double grade = assessment.getGrade();
+        if (grade != 0.0) {
+            table.addCell(grade, 2, "%");
         } else {
-            std::cout << "| " << std::setw(idWidth) << std::left << "#"
-                      << " | " << std::setw(nameWidth) << std::left << "Lab" 
-                      << " | " << std::setw(weightWidth) << std::right << "Weight"
-                      << " | " << std::setw(gradeWidth) << std::right << "Grade"
-                      << " | " << std::setw(statusWidth) << std::left << "Status" << " |"
-                      << "\n";
+            table.addCell("N/A");
         }
 
-        std::cout << horizontalLine << "\n";
-    
-    // Data rows for lab section
-    for (int i = 0; i < chosenCourse.getAssessmentCount(); i++) {
-        const Assessment& assessment = assessments[i];
+        table.addCell(assessment.getIsComplete() ? "Complete" : "Pending");
+    }
+    table.addRule();
+}
 
-        if (!assessment.getIsTheory()) {
+void renderAssessmentsDetails(TableRenderer& table, const Course& chosenCourse, bool careForComplete) {
+    GradeSummary summary = chosenCourse.calculateSummary(careForComplete);
 
-            bool isComplete = assessment.getIsComplete();
-            double grade = assessment.getGrade();
-            
-            // Format ID column
-            std::cout << "| " << std::setw(idWidth) << std::left << (i + 1);
-            
-            // Format Name column
-            std::string name = assessment.getName();
-            if (name.length() > nameWidth) {
-                name = name.substr(0, nameWidth - 3) + "...";
-            }
-            std::cout << " | " << std::setw(nameWidth) << std::left << name;
-            
-            // Format Weight column
-            std::cout << " | " << std::setw(weightWidth - 1) << std::right << assessment.getWeight() << "%";
-            
-            // Format Grade column
-            if (grade != 0.0) {
-                std::cout << " | " << std::setw(gradeWidth - 1) << std::right << std::fixed << std::setprecision(2) << grade << "%";
-            } else {
-                std::cout << " | " << std::setw(gradeWidth) << std::right << "N/A";
-            }
-            
-            // Format Status column
-            std::cout << " | " << std::setw(statusWidth) << std::left 
-                    << (isComplete ? "Complete" : "Pending") << " |";
-            
-            std::cout << "\n";
-        }
+    table.addLine("\nAssessments:");
+    table.addRule();
+    renderAssessmentSection(table, chosenCourse, true, summary.theoryGrade);
+    renderAssessmentSection(table, chosenCourse, false, summary.labGrade);
+}
+
+void viewAssessmentsDetails(const Course& chosenCourse, bool careForComplete, std::ostream& out = std::cout) {
+    TableRenderer table = makeAssessmentTable(chosenCourse.getAssessmentCount());
+    renderAssessmentsDetails(table, chosenCourse, careForComplete);
+    table.writeTo(out);
+}
+
+// assessments of a hypothetical course followed by its final grade
+void viewProjectedCourse(const Course& tempCourse, std::ostream& out) {
+    TableRenderer table = makeAssessmentTable(tempCourse.getAssessmentCount());
+    renderAssessmentsDetails(table, tempCourse, false);
+
+    std::string finalGradeText = "Final Grade would be: ";
+    TableRenderer::appendNumber(finalGradeText, tempCourse.calculateOverallGrade(false), 2);
+    finalGradeText += '%';
+    table.addSpanningRow(finalGradeText);
+    table.addRule();
+    table.writeTo(out);
+}
+
+void printCourseDetails(const Course& chosenCourse, std::ostream& out) {
+    GradeSummary summary = chosenCourse.calculateSummary(true);
+    TableRenderer table = makeAssessmentTable(chosenCourse.getAssessmentCount());
+
+    table.addLine(" === " + chosenCourse.getCourseCode() + " === ");
+    table.addLine(chosenCourse.getIsA5050Course() ? "Type: 50/50 Course" : "Type: Regular Course");
+    std::string creditsText = "Credits: ";
+    TableRenderer::appendNumber(creditsText, chosenCourse.getCredits(), 2);
+    creditsText += "  Term: " + (chosenCourse.getTerm().empty() ? std::string("-") : chosenCourse.getTerm());
+    table.addLine(creditsText);
+    table.addLine("Assessment Count: " + std::to_string(chosenCourse.getAssessmentCount()));
+
+    if (chosenCourse.getAssessmentCount() > 0) {
+        renderAssessmentsDetails(table, chosenCourse, true);
+    }
+
+    // Summary rows
+    std::string overallGradeText;
+    if (summary.isTotalWeightValid) {
+        overallGradeText = "Overall Grade: ";
+        TableRenderer::appendNumber(overallGradeText, summary.overallGrade, 2);
+        overallGradeText += '%';
+    } else {
+        std::string gradeText = "My grade so far: ";
+        TableRenderer::appendNumber(gradeText, summary.gradeSoFar, 2);
+        gradeText += "% (based on ";
+        TableRenderer::appendNumber(gradeText, summary.completeWeight, 2);
+        gradeText += "% of course weight)";
+        table.addSpanningRow(gradeText);
+        overallGradeText = "Invalid Total Weight: Total weighting must equal to 100%";
     }
-    std::cout << horizontalLine << "\n";
+    table.addSpanningRow(overallGradeText);
+    table.addRule();
 
+    table.writeTo(out);
 }
 
-void editCourse(Course& chosenCourse, CourseManager& manager) {
+void editCourse(int courseIndex, CourseManager& manager) {
+    Course& chosenCourse = manager.getCourse(courseIndex);
     int choice;
     do {
-        clearScreen();
-        std::cout << "==== Edit Course: " << chosenCourse.getCourseCode() << " ====\n";
-        std::cout << "1. Rename course\n";
-        std::cout << "2. Add assessment\n";
-        std::cout << "3. Edit existing assessment\n";
-        std::cout << "4. Delete assessment\n";
-        std::cout << "5. Toggle 50/50 course type\n";
-        std::cout << "6. Back to course menu\n";
-        std::cout << "=============================\n";
+        std::ostringstream frame;
+        printCourseDetails(chosenCourse, frame);
+        frame << "\n==== Edit Course: " << chosenCourse.getCourseCode() << " ====\n"
+              << "1. Rename course\n"
+              << "2. Add assessment\n"
+              << "3. Edit existing assessment\n"
+              << "4. Delete assessment\n"
+              << "5. Toggle 50/50 course type\n"
+              << "6. Set credits and term\n"
+              << "7. Back to course menu\n"
+              << "=============================\n";
+        showScreen(frame.str());
         
         choice = getInput<int>("Enter your choice: ");
         switch (choice) {
             case 1: {
                 // Rename course
                 std::string newCode = getStringInput("Enter new course code: ");
-                chosenCourse.setCourseCode(newCode);
+                int existing = manager.findCourse(newCode);
+                if (existing >= 0 && existing != courseIndex) {
+                    std::cout << "Warning: a course with code " << newCode << " already exists.\n";
+                }
+                manager.setCourseCode(courseIndex, newCode);
                 std::cout << "Course code updated successfully!\n";
-                manager.saveToFile();
                 pauseForUser();
                 break;
             }
@@ -295,9 +353,8 @@ void editCourse(Course& chosenCourse, CourseManager& manager) {
                 }
                 
                 Assessment newAssessment(name, weight, grade, isTheory, isComplete);
-                chosenCourse.addAssessment(newAssessment);
+                manager.addAssessment(courseIndex, newAssessment);
                 std::cout << "Assessment added successfully!\n";
-                manager.saveToFile();
                 pauseForUser();
                 break;
             }
@@ -308,7 +365,7 @@ void editCourse(Course& chosenCourse, CourseManager& manager) {
                 std::cout << "==== Edit Assessment ====\n";
                 
                 // Display assessments
-                const std::vector<Assessment>& assessments = chosenCourse.getAllAssessments();
+                AssessmentRange assessments = chosenCourse.getAssessments();
                 if (assessments.empty()) {
                     std::cout << "No assessments to edit.\n";
                     pauseForUser();
@@ -350,27 +407,28 @@ void editCourse(Course& chosenCourse, CourseManager& manager) {
                 switch (propertyChoice) {
                     case 1: {
                         std::string newName = getStringInput("Enter new name: ");
-                        chosenCourse.updateAssessmentName(assessmentIndex, newName);
+                        manager.updateAssessmentName(courseIndex, assessmentIndex, newName);
                         break;
                     }
                     case 2: {
                         double newWeight = getInput<double>("Enter new weight (%): ");
-                        chosenCourse.updateAssessmentWeight(assessmentIndex, newWeight);
+                        manager.updateAssessmentWeight(courseIndex, assessmentIndex, newWeight);
                         break;
                     }
                     case 3: {
                         bool newIsTheory = getInput<char>("Is this a theory assessment? (y/n for lab): ") == 'y';
-                        chosenCourse.updateAssessmentType(assessmentIndex, newIsTheory);
+                        manager.updateAssessmentType(courseIndex, assessmentIndex, newIsTheory);
                         break;
                     }
                     case 4: {
                         bool newIsComplete = getInput<char>("Is this assessment complete? (y/n): ") == 'y';
-                        chosenCourse.updateAssessmentCompletionStatus(assessmentIndex, newIsComplete);
+                        bool wasComplete = assessments[assessmentIndex].getIsComplete();
+                        manager.updateAssessmentCompletionStatus(courseIndex, assessmentIndex, newIsComplete);
                         
                         // If marked as complete, ask for grade
-                        if (newIsComplete && !assessments[assessmentIndex].getIsComplete()) {
+                        if (newIsComplete && !wasComplete) {
                             double newGrade = getInput<double>("Enter grade received (%): ");
-                            chosenCourse.updateAssessmentGrade(assessmentIndex, newGrade);
+                            manager.updateAssessmentGrade(courseIndex, assessmentIndex, newGrade);
                         }
                         break;
                     }
@@ -379,7 +437,7 @@ void editCourse(Course& chosenCourse, CourseManager& manager) {
                             std::cout << "Cannot set grade for incomplete assessment.\n";
                         } else {
                             double newGrade = getInput<double>("Enter new grade (%): ");
-                            chosenCourse.updateAssessmentGrade(assessmentIndex, newGrade);
+                            manager.updateAssessmentGrade(courseIndex, assessmentIndex, newGrade);
                         }
                         break;
                     }
@@ -390,7 +448,6 @@ void editCourse(Course& chosenCourse, CourseManager& manager) {
                 }
                 
                 std::cout << "Assessment updated successfully!\n";
-                manager.saveToFile();
                 pauseForUser();
                 break;
             }
@@ -400,7 +457,7 @@ void editCourse(Course& chosenCourse, CourseManager& manager) {
                 clearScreen();
                 std::cout << "==== Delete Assessment ====\n";
                 
-                const std::vector<Assessment>& assessments = chosenCourse.getAllAssessments();
+                AssessmentRange assessments = chosenCourse.getAssessments();
                 if (assessments.empty()) {
                     std::cout << "No assessments to delete.\n";
                     pauseForUser();
@@ -426,9 +483,8 @@ void editCourse(Course& chosenCourse, CourseManager& manager) {
                 // Confirm deletion
                 char confirm = getInput<char>("Are you sure you want to delete this assessment? (y/n): ");
                 if (confirm == 'y') {
-                    chosenCourse.removeAssessment(assessmentIndex - 1);
+                    manager.removeAssessment(courseIndex, assessmentIndex - 1);
                     std::cout << "Assessment deleted successfully!\n";
-                    manager.saveToFile(); // Save changes to file
                 } else {
                     std::cout << "Deletion cancelled.\n";
                 }
@@ -445,16 +501,35 @@ void editCourse(Course& chosenCourse, CourseManager& manager) {
                                              " course. Change? (y/n): ");
                 
                 if (confirm == 'y') {
-                    chosenCourse.setIsA5050Course(!isA5050Course);
+                    manager.setIsA5050Course(courseIndex, !isA5050Course);
                     std::cout << "Course type updated successfully!\n";
-                    manager.saveToFile();
                 }
                 
                 pauseForUser();
                 break;
             }
                 
-            case 6:
+            case 6: {
+                // Credits and term, used by the GPA
+                std::string prompt = "Credits (currently ";
+                TableRenderer::appendNumber(prompt, chosenCourse.getCredits(), 2);
+                double credits = getInput<double>(prompt + "): ");
+                if (credits < 0) {
+                    std::cout << "Credits can't be negative.\n";
+                    pauseForUser();
+                    break;
+                }
+                std::string term = getStringInput("Term (currently " +
+                                                  (chosenCourse.getTerm().empty() ? std::string("none") : chosenCourse.getTerm()) +
+                                                  ", empty for none): ");
+                manager.setCourseCredits(courseIndex, credits);
+                manager.setCourseTerm(courseIndex, term);
+                std::cout << "Credits and term updated successfully!\n";
+                pauseForUser();
+                break;
+            }
+                
+            case 7:
                 // Return to course menu
                 break;
                 
@@ -462,74 +537,111 @@ void editCourse(Course& chosenCourse, CourseManager& manager) {
                 std::cout << "Invalid choice. Please try again.\n";
                 pauseForUser();
         }
-    } while (choice != 6);
+    } while (choice != 7);
+}
+
+// sample the incomplete assessments many times and report the spread of final grades
+void runMonteCarloSimulation(const Course& chosenCourse) {
+    std::cout << "==== Monte Carlo Grade Simulation ====\n\n";
+
+    MonteCarlo simulation(chosenCourse);
+    if (simulation.getIncompleteCount() == 0) {
+        std::cout << "No incomplete assessments found to simulate grades for.\n";
+        return;
+    }
+
+    AssessmentRange assessments = chosenCourse.getAssessments();
+    std::cout << "Each pending assessment is drawn from a normal distribution fitted to\n"
+              << "your completed grades (kept within 0-100%):\n";
+    for (int i = 0; i < simulation.getIncompleteCount(); i++) {
+        MonteCarlo::Distribution distribution = simulation.getDistribution(i);
+        std::cout << "  " << std::left << std::setw(25) << assessments[simulation.getAssessmentIndex(i)].getName()
+                  << " mean " << std::fixed << std::setprecision(2) << distribution.mean
+                  << "%, spread " << distribution.standardDeviation << "%\n";
+    }
+    std::cout << "\n";
+
+    double goal = getInput<double>("What's your goal final grade (%): ");
+    simulation.setGoalGrade(goal);
+
+    auto start = std::chrono::steady_clock::now();
+    SimulationResult result = simulation.run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "\n==== Simulation Results (" << result.trialCount << " trials, "
+              << std::setprecision(3) << elapsed.count() << " s) ====\n";
+    std::cout << std::setprecision(2);
+    std::cout << "Expected final grade: " << result.mean << "% (+/- " << result.standardDeviation << "%)\n";
+    std::cout << "Range: " << result.minimum << "% to " << result.maximum << "%\n";
+    std::cout << "Chance of passing (50%): " << result.passProbability * 100 << "%\n";
+    std::cout << "Chance of reaching " << goal << "%: " << result.goalProbability * 100 << "%\n\n";
+
+    std::cout << "Percentiles:\n";
+    for (double percent : {5.0, 25.0, 50.0, 75.0, 95.0}) {
+        std::cout << "  " << std::right << std::setw(3) << static_cast<int>(percent) << "th: "
+                  << std::setw(6) << result.getPercentile(percent) << "%\n";
+    }
+
+    // ten-point buckets, bars scaled to the fullest one
+    std::cout << "\nDistribution:\n";
+    uint64_t buckets[10];
+    uint64_t fullest = 1;
+    for (int bucket = 0; bucket < 10; bucket++) {
+        buckets[bucket] = result.countBetween(bucket * 10.0, bucket == 9 ? 100.01 : (bucket + 1) * 10.0);
+        fullest = std::max(fullest, buckets[bucket]);
+    }
+    for (int bucket = 0; bucket < 10; bucket++) {
+        int barLength = static_cast<int>(40 * buckets[bucket] / fullest);
+        std::cout << "  " << std::setw(3) << bucket * 10 << "-" << std::left << std::setw(3) << (bucket + 1) * 10
+                  << std::right << " | " << std::string(barLength, '#')
+                  << (buckets[bucket] > 0 && barLength == 0 ? "." : "") << "\n";
+    }
 }
 
-void showCourseOptions(Course& chosenCourse, CourseManager& manager) {
+void showCourseOptions(int courseIndex, CourseManager& manager) {
+    Course& chosenCourse = manager.getCourse(courseIndex);
     int choice;
 do {
-    clearScreen();
-    std::cout << "==== Select a Choice ====\n";
-    std::cout << "1. Edit Course\n";
-    std::cout << "2. Calculate Minimum Grades Needed for Target Final Grade\n";
-    std::cout << "3. Simulate Final Grade Based on Hypothetical Scores\n";
-    std::cout << "4. Back to Main Menu\n";
-    std::cout << "=========================\n";
+    // course details on top, so edits show up as the few table lines that changed
+    std::ostringstream frame;
+    printCourseDetails(chosenCourse, frame);
+    frame << "\n==== Select a Choice ====\n"
+          << "1. Edit Course\n"
+          << "2. Calculate Minimum Grades Needed for Target Final Grade\n"
+          << "3. Simulate Final Grade Based on Hypothetical Scores\n"
+          << "4. Simulate Final Grade Distribution (Monte Carlo)\n"
+          << "5. Back to Main Menu\n"
+          << "=========================\n";
+    showScreen(frame.str());
     
     choice = getInput<int>("Enter your choice: ");
     
     switch (choice) {
         case 1:
-            editCourse(chosenCourse, manager);
+            editCourse(courseIndex, manager);
             break;
             
         case 2:
             clearScreen();
             {
+                GradeSummary summary = chosenCourse.calculateSummary(true);
                 std::cout << "My grade so far: " << std::fixed << std::setprecision(2) 
-                          << chosenCourse.calculateGradeSoFar(true) << "%" << std::endl;
-                std::cout << "Number of incomplete assessments: " << chosenCourse.getIncompleteAssessmentCount() << std::endl;
+                          << summary.gradeSoFar << "%" << std::endl;
+                std::cout << "Number of incomplete assessments: " << summary.incompleteCount << std::endl;
                 double goal = getInput<double>("What's your goal final grade (%): ");
-                std::vector<Assessment> resultingAssessments = chosenCourse.calculateRequiredGrades(goal);
+                bool isAchievable;
+                std::vector<Assessment> resultingAssessments = chosenCourse.calculateRequiredGrades(goal, isAchievable);
         
-                // Check if the resulting assessments vector is empty
-                if (resultingAssessments.empty()) {
+                if (!isAchievable) {
                     std::cout << "\n==== Target Grade Analysis ====\n";
                     std::cout << "Achieving a grade of " << std::fixed << std::setprecision(2) 
                               << goal << "% is impossible with the current assessment structure.\n";
                 } else {
                     Course tempCourse(chosenCourse.getCourseCode(), 
-                                     resultingAssessments, 
+                                     std::move(resultingAssessments), 
                                      chosenCourse.getIsA5050Course());
         
-                    viewAssessmentsDetails(tempCourse, resultingAssessments, false);
-        
-                    const int idWidth = 3;
-                    const int nameWidth = 25;
-                    const int weightWidth = 8;
-                    const int gradeWidth = 8;
-                    const int statusWidth = 10;
-                
-                    // Calculate total width for horizontal line
-                    const int totalWidth = idWidth + 1 + nameWidth + 1 + weightWidth + 1 + gradeWidth + 1 + statusWidth + 12;
-                
-                    std::string horizontalLine(totalWidth, '-');
-        
-                    // Summary row 
-                    std::stringstream overallGradeStream;
-                    std::string overallGradeText;
-        
-                    overallGradeStream << std::fixed << std::setprecision(2) << tempCourse.calculateOverallGrade(false);
-                    overallGradeText = "Final Grade would be: " + overallGradeStream.str() + "%";
-                    
-                    // Check if spaces needed is negative to prevent string length error
-                    int spacesNeeded = totalWidth - overallGradeText.length() - 4;
-                    if (spacesNeeded < 0) spacesNeeded = 0;
-                    
-                    std::cout << "| " << std::left << overallGradeText
-                            << std::string(spacesNeeded, ' ') << " |\n";
-                            
-                    std::cout << horizontalLine << "\n";
+                    viewProjectedCourse(tempCourse, std::cout);
                 }
             }
             pauseForUser();
@@ -544,9 +656,10 @@ do {
                 bool madeChanges = false;
                 
                 // Show current grade status
+                GradeSummary summary = chosenCourse.calculateSummary(true);
                 std::cout << "Your current grade: " << std::fixed 
-                          << std::setprecision(2) << chosenCourse.calculateGradeSoFar(true) 
-                          << "% (based on " << chosenCourse.getTotalWeight() << "% of course weight)\n\n";
+                          << std::setprecision(2) << summary.gradeSoFar 
+                          << "% (based on " << summary.completeWeight << "% of course weight)\n\n";
                 
                 // Ask for hypothetical grades for incomplete assessments
                 std::cout << "Enter hypothetical grades for incomplete assessments:\n";
@@ -558,11 +671,8 @@ do {
                                   << " (Weight: " << assessment.getWeight() << "%)"
                                   << " - Currently not completed\n";
                                   
-                        double hypotheticalGrade = getInput<double>("Enter hypothetical grade (%): ");
-                        
-                        // Keep the grade within reasonable bounds
-                        if (hypotheticalGrade < 0.0) hypotheticalGrade = 0.0;
-                        if (hypotheticalGrade > 100.0) hypotheticalGrade = 100.0;
+                        double hypotheticalGrade = clampGrade(getInput<double>("Enter hypothetical grade (%): "),
+                                                              std::cout);
                         
                         assessment.setGrade(hypotheticalGrade);
                         // Don't change isComplete status - we're just simulating
@@ -575,7 +685,7 @@ do {
                 if (madeChanges) {
                     // Create a temporary course with our modified assessments
                     Course tempCourse(chosenCourse.getCourseCode(), 
-                                     simulationAssessments, 
+                                     std::move(simulationAssessments), 
                                      chosenCourse.getIsA5050Course());
                                      
                     // Calculate and display the hypothetical grade
@@ -587,32 +697,7 @@ do {
                               
                     // Show the detailed breakdown
                     std::cout << "\nDetailed breakdown:\n";
-                    viewAssessmentsDetails(tempCourse, simulationAssessments, false);
-
-                    const int idWidth = 3;
-                    const int nameWidth = 25;
-                    const int weightWidth = 8;
-                    const int gradeWidth = 8;
-                    const int statusWidth = 10;
-                
-                    // Calculate total width for horizontal line
-                    const int totalWidth = idWidth + 1 + nameWidth + 1 + weightWidth + 1 + gradeWidth + 1 + statusWidth + 12;
-                
-                    std::string horizontalLine(totalWidth, '-');
-
-                    // Summary row 
-                    std::stringstream gradeStream;
-                    std::stringstream weightStream;
-                    
-                    std::stringstream overallGradeStream;
-                    std::string overallGradeText;
-
-                    overallGradeStream << std::fixed << std::setprecision(2) << tempCourse.calculateOverallGrade(false);
-                    overallGradeText = "Final Grade would be: " + overallGradeStream.str() + "%";
-                    std::cout << "| " << std::left << overallGradeText
-                            << std::string(totalWidth - overallGradeText.length() - 4, ' ') << " |\n";
-                            
-                    std::cout << horizontalLine << "\n";
+                    viewProjectedCourse(tempCourse, std::cout);
                 } else {
                     std::cout << "\nNo incomplete assessments found to simulate grades for.\n";
                 }
@@ -620,13 +705,19 @@ do {
             pauseForUser();
             break;
         case 4:
+            clearScreen();
+            runMonteCarloSimulation(chosenCourse);
+            pauseForUser();
+            break;
+
+        case 5:
             break;
             
         default:
             std::cout << "Invalid choice. Please try again.\n";
             pauseForUser();
     }
-} while (choice != 4);
+} while (choice != 5);
 }
 
 void viewCourseDetails(CourseManager& manager) {
@@ -654,57 +745,9 @@ void viewCourseDetails(CourseManager& manager) {
     }
     
     choice--;
-    Course& chosenCourse = manager.getCourse(choice);
-    const std::vector<Assessment> assessments = chosenCourse.getAllAssessments();
-    
-    std::cout << "\n === " << chosenCourse.getCourseCode() << " === \n";
-    std::cout << "Type: " << (chosenCourse.getIsA5050Course() ? "50/50 Course" : "Regular Course") << "\n";
-    std::cout << "Assessment Count: " << chosenCourse.getAssessmentCount() << "\n";
-
-    const int idWidth = 3;
-    const int nameWidth = 25;
-    const int weightWidth = 8;
-    const int gradeWidth = 8;
-    const int statusWidth = 10;
-
-    // Calculate total width for horizontal line
-    const int totalWidth = idWidth + 1 + nameWidth + 1 + weightWidth + 1 + gradeWidth + 1 + statusWidth + 12;
-
-    std::string horizontalLine(totalWidth, '-');
-    
-    if (chosenCourse.getAssessmentCount() > 0) {
-        viewAssessmentsDetails(chosenCourse, assessments, true);
-    }
-                
-        // Summary row 
-        std::stringstream gradeStream;
-        std::stringstream weightStream;
-        
-        std::stringstream overallGradeStream;
-        std::string overallGradeText;
-        if (chosenCourse.isTotalWeightValid()) {
-            overallGradeStream << std::fixed << std::setprecision(2) << chosenCourse.calculateOverallGrade(true);
-            overallGradeText = "Overall Grade: " + overallGradeStream.str() + "%";
-        } else {
-            gradeStream << std::fixed << std::setprecision(2) << chosenCourse.calculateGradeSoFar(true);
-            std::string gradeText = "My grade so far: " + gradeStream.str() + "%";
-    
-            weightStream << std::fixed << std::setprecision(2) << chosenCourse.getTotalWeight();
-            std::string weightText = " (based on " + weightStream.str() + "% of course weight)";
-            
-            std::cout << "| " << std::left << gradeText << weightText
-                     << std::string(totalWidth - gradeText.length() - 39, ' ') << " |\n";
-            overallGradeText = "Invalid Total Weight: Total weighting must equal to 100%";
-        }
-        
-        std::cout << "| " << std::left << overallGradeText
-                  << std::string(totalWidth - overallGradeText.length() - 4, ' ') << " |\n";
-                  
-        std::cout << horizontalLine << "\n";
 
-        //course menu
-        pauseForUser();
-        showCourseOptions(chosenCourse, manager);
+    //course menu, which shows the course details above it
+    showCourseOptions(choice, manager);
 }
 
 void deleteCourse(CourseManager& manager) {
@@ -746,17 +789,16 @@ void deleteCourse(CourseManager& manager) {
 }
 
 // Main menu function
-void showMainMenu(CourseManager& manager) {
+void showMainMenu(CourseManager& manager, const GpaTracker& gpa) {
     int choice;
     do {
-        clearScreen();
-        std::cout << "==== Grade Calculator ====\n";
-        std::cout << "1. Add new course\n";
-        std::cout << "2. View all courses\n";
-        std::cout << "3. View/edit course details\n";
-        std::cout << "4. Delete course\n";
-        std::cout << "5. Exit\n";
-        std::cout << "==========================\n";
+        showScreen("==== Grade Calculator ====\n"
+                   "1. Add new course\n"
+                   "2. View all courses\n"
+                   "3. View/edit course details\n"
+                   "4. Delete course\n"
+                   "5. Exit\n"
+                   "==========================\n");
         
         choice = getInput<int>("Enter your choice: ");
         
@@ -770,6 +812,7 @@ void showMainMenu(CourseManager& manager) {
             case 2:
                 clearScreen();
                 displayCourses(manager);
+                displayGpa(gpa);
                 pauseForUser();
                 break;
                 
@@ -796,11 +839,436 @@ void showMainMenu(CourseManager& manager) {
     } while (choice != 5);
 }
 
-int main() {
-    // Create course manager with default file path
-    CourseManager manager("courses.json");
+// ==== Headless batch mode ====
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--file PATH | --students DIR] [--diff-redraw]\n"
+              << "       [--stats-in FILE]... [--stats-out FILE] [COMMAND]\n"
+              << "Without a command the interactive menu is started; --diff-redraw makes it\n"
+              << "repaint only the screen lines that changed.\n\n"
+              << "Commands (one tab-separated line per course on stdout):\n"
+              << "  report          grade so far, overall and section grades\n"
+              << "  required GOAL   uniform grade needed on the remaining assessments\n"
+              << "  whatif GRADE    final grade if every incomplete assessment scores GRADE\n"
+              << "  required-table [FROM TO STEP]\n"
+              << "                  required grade for every goal from FROM to TO (default 50 100 1)\n"
+              << "  stats           instead one line of grade statistics per course code and\n"
+              << "                  per assessment name, ending in a 5%-wide histogram\n"
+              << "  gpa             instead credit-weighted GPA of finished courses per term and\n"
+              << "                  cumulative (per student with --students)\n\n"
+              << "--students DIR runs a command over every STUDENT.json file in DIR at once,\n"
+              << "with the student id as the first column.\n\n"
+              << "With stats, --stats-in FILE (repeatable) merges statistics saved by another\n"
+              << "run, on this machine or another, and --stats-out FILE saves the result.\n";
+}
+
+bool parseNumberArgument(const char* text, double& value) {
+    std::istringstream stream(text);
+    return (stream >> value) && stream.eof();
+}
+
+// Column headers and per-course fields shared by the single-file and cohort batches.
+const char* getBatchHeader(const std::string& command) {
+    if (command == "report") {
+        return "course\ttype\tassessments\tcompleteWeight\tgradeSoFar\toverallGrade\ttheoryGrade\tlabGrade\n";
+    } else if (command == "required") {
+        return "course\tgoal\trequiredGrade\tachievable\n";
+    }
+    return "course\thypotheticalGrade\tfinalGrade\n";
+}
+
+void appendReportFields(std::string& output, const GradeSummary& summary, bool isA5050Course, int assessmentCount) {
+    output += isA5050Course ? "50/50\t" : "regular\t";
+    output += std::to_string(assessmentCount);
+    output += '\t';
+    TableRenderer::appendNumber(output, summary.completeWeight, 2);
+    output += '\t';
+    TableRenderer::appendNumber(output, summary.gradeSoFar, 2);
+    output += '\t';
+    if (summary.isTotalWeightValid) {
+        TableRenderer::appendNumber(output, summary.overallGrade, 2);
+    } else {
+        output += '-';
+    }
+    output += '\t';
+    TableRenderer::appendNumber(output, summary.theoryGrade, 2);
+    output += '\t';
+    TableRenderer::appendNumber(output, summary.labGrade, 2);
+    output += '\n';
+}
+
+void appendRequiredFields(std::string& output, double goal, const CourseEvaluation& evaluation) {
+    TableRenderer::appendNumber(output, goal, 2);
+    output += '\t';
+    TableRenderer::appendNumber(output, evaluation.requiredGrade, 2);
+    output += evaluation.isGoalAchievable ? "\tyes\n" : "\tno\n";
+}
+
+void appendWhatIfFields(std::string& output, const Course& course, double hypotheticalGrade) {
+    std::vector<Assessment> simulationAssessments = course.calculateWhatIf();
+    for (Assessment& assessment : simulationAssessments) {
+        if (!assessment.getIsComplete()) {
+            assessment.setGrade(hypotheticalGrade);
+        }
+    }
+    Course tempCourse(course.getCourseCode(), std::move(simulationAssessments), course.getIsA5050Course());
+    TableRenderer::appendNumber(output, hypotheticalGrade, 2);
+    output += '\t';
+    TableRenderer::appendNumber(output, tempCourse.calculateOverallGrade(false), 2);
+    output += '\n';
+}
+
+bool writeBatchOutput(const std::string& output) {
+    std::cout.write(output.data(), output.size());
+    std::cout.flush();
+    return std::cout.good();
+}
+
+void appendStatisticsRow(std::string& output, const char* scope, std::string_view key, const GradeStatistics& statistics) {
+    output += scope;
+    output += '\t';
+    output += key;
+    output += '\t';
+    output += std::to_string(statistics.getCount());
+    for (double value : {statistics.getMean(), statistics.getStandardDeviation(), statistics.getMinimum()}) {
+        output += '\t';
+        TableRenderer::appendNumber(output, value, 2);
+    }
+    for (double q : {0.05, 0.25, 0.5, 0.75, 0.95}) {
+        output += '\t';
+        TableRenderer::appendNumber(output, statistics.getQuantile(q), 2);
+    }
+    output += '\t';
+    TableRenderer::appendNumber(output, statistics.getMaximum(), 2);
+    for (uint64_t binCount : statistics.getHistogram()) {
+        output += '\t';
+        output += std::to_string(binCount);
+    }
+    output += '\n';
+}
+
+// shard files of the "stats" command: merged in before printing, and the result written out
+struct StatisticsFiles {
+    std::vector<std::string> inputs;
+    std::string output;
+};
+
+// the "stats" command: grade distribution over all courses, per course code and per assessment name
+int writeStatistics(const std::vector<Course>& courses, const StatisticsFiles& files) {
+    CohortStatistics statistics = CohortStatistics::compute(courses);
+    for (const std::string& path : files.inputs) {
+        CohortStatistics shard;
+        if (!shard.load(path)) {
+            return 1;
+        }
+        statistics.merge(shard);
+    }
+    statistics.compress();
+    if (!files.output.empty() && !statistics.save(files.output)) {
+        return 1;
+    }
+
+    // then one count per histogram bin, headed by its range
+    std::string output = "scope\tkey\tcount\tmean\tstddev\tmin\tp5\tp25\tmedian\tp75\tp95\tmax";
+    const int binWidth = 100 / GradeStatistics::binCount;
+    for (int bin = 0; bin < GradeStatistics::binCount; bin++) {
+        output += '\t';
+        output += std::to_string(bin * binWidth) + '-' + std::to_string((bin + 1) * binWidth);
+    }
+    output += '\n';
+    appendStatisticsRow(output, "all", "-", statistics.getAllCourses());
+    for (const std::string& courseCode : statistics.getCourseCodes()) {
+        appendStatisticsRow(output, "course", courseCode, *statistics.getCourseCodeStatistics(courseCode));
+    }
+    for (const std::string& name : statistics.getAssessmentNames()) {
+        appendStatisticsRow(output, "assessment", name, *statistics.getAssessmentStatistics(name));
+    }
+    return writeBatchOutput(output) ? 0 : 1;
+}
+
+// "gpa": courses, credits and GPA on the default scale
+void appendGpaFields(std::string& output, const GpaTotals& totals) {
+    output += std::to_string(totals.courseCount);
+    output += '\t';
+    TableRenderer::appendNumber(output, totals.credits, 2);
+    output += '\t';
+    TableRenderer::appendNumber(output, totals.getGpa(), 2);
+    output += '\n';
+}
+
+// "required-table": header with the goals, then one row per course of required grades ("-" when out of reach)
+void appendRequiredTableHeader(std::string& output, const std::vector<double>& goals) {
+    output += "course";
+    for (double goal : goals) {
+        output += '\t';
+        TableRenderer::appendNumber(output, goal, 2);
+    }
+    output += '\n';
+}
+
+void appendRequiredTableFields(std::string& output, const RequiredGradeMatrix& matrix, int row) {
+    for (size_t goal = 0; goal < matrix.getGoalCount(); goal++) {
+        if (goal > 0) {
+            output += '\t';
+        }
+        if (matrix.getIsAchievable(row, goal)) {
+            TableRenderer::appendNumber(output, matrix.getRequiredGrade(row, goal), 2);
+        } else {
+            output += '-';
+        }
+    }
+    output += '\n';
+}
+
+// Run one calculation over every course and write the results in a single pass.
+// The data file is opened read-only (mapped when the snapshot is current), and
+// nothing prompts, clears the screen or saves.
+int runBatch(const std::string& filePath, const std::string& command, double argument,
+             const std::vector<double>& goals, const StatisticsFiles& statisticsFiles) {
+    CourseManager manager(filePath, true);
+    if (!manager.isLoaded()) {
+        // an empty report would look like a file with no courses
+        std::cerr << "Error: could not load courses from " << filePath << "\n";
+        return 1;
+    }
+    if (command == "stats") {
+        return writeStatistics(manager.getAllCourses(), statisticsFiles);
+    }
+    if (command == "gpa") {
+        const std::vector<Course>& courses = manager.getAllCourses();
+        std::vector<TermGpa> terms;
+        GpaTotals cumulative = GpaTracker::calculate(courses.data(), courses.size(), GradeScale::makeDefault(),
+                                                     false, &terms);
+        std::string output = "term\tcourses\tcredits\tgpa\n";
+        for (const TermGpa& term : terms) {
+            output += term.term.empty() ? "-" : term.term;
+            output += '\t';
+            appendGpaFields(output, term.totals);
+        }
+        output += "cumulative\t";
+        appendGpaFields(output, cumulative);
+        return writeBatchOutput(output) ? 0 : 1;
+    }
+    if (command == "required-table") {
+        RequiredGradeMatrix matrix = manager.calculateRequiredGradeMatrix(goals);
+        std::string output;
+        output.reserve(8 * (goals.size() + 1) * (manager.getCourseCount() + 1));
+        appendRequiredTableHeader(output, goals);
+        for (int i = 0; i < manager.getCourseCount(); i++) {
+            output += manager.isMapped() ? std::string(manager.getMappedCourse(i).getCourseCode())
+                                         : manager.getCourse(i).getCourseCode();
+            output += '\t';
+            appendRequiredTableFields(output, matrix, i);
+        }
+        return writeBatchOutput(output) ? 0 : 1;
+    }
+
+    // rows are appended to one preallocated buffer with to_chars formatting
+    std::string output;
+    output.reserve(64 * (manager.getCourseCount() + 1));
+    output += getBatchHeader(command);
+
+    // report and required read every course once, evaluated in parallel up front
+    std::vector<CourseEvaluation> evaluations;
+    if (command != "whatif") {
+        evaluations = manager.evaluateAll(argument);
+    }
+
+    for (int i = 0; i < manager.getCourseCount(); i++) {
+        // with a mapped snapshot the row reads straight from the mapping
+        std::string courseCode;
+        bool isA5050Course;
+        int assessmentCount;
+        if (manager.isMapped()) {
+            MappedCourseView view = manager.getMappedCourse(i);
+            courseCode = view.getCourseCode();
+            isA5050Course = view.getIsA5050Course();
+            assessmentCount = view.getAssessmentCount();
+        } else {
+            const Course& course = manager.getCourse(i);
+            courseCode = course.getCourseCode();
+            isA5050Course = course.getIsA5050Course();
+            assessmentCount = course.getAssessmentCount();
+        }
+        output += courseCode;
+        output += '\t';
+
+        if (command == "report") {
+            appendReportFields(output, evaluations[i].summary, isA5050Course, assessmentCount);
+        } else if (command == "required") {
+            appendRequiredFields(output, argument, evaluations[i]);
+        } else if (manager.isMapped()) {
+            // only this one course is materialised at a time
+            appendWhatIfFields(output, manager.getMappedCourse(i).toCourse(), argument);
+        } else {
+            appendWhatIfFields(output, manager.getCourse(i), argument);
+        }
+    }
+
+    return writeBatchOutput(output) ? 0 : 1;
+}
+
+// The same commands over a directory of per-student files, loaded into one
+// StudentRegistry and evaluated in one parallel pass, with a leading student column.
+int runCohortBatch(const std::string& directoryPath, const std::string& command, double argument,
+                   const std::vector<double>& goals, const StatisticsFiles& statisticsFiles) {
+    StudentRegistry registry;
+    if (!registry.loadDirectory(directoryPath) && registry.getStudentCount() == 0) {
+        return 1;
+    }
+    if (command == "stats") {
+        return writeStatistics(registry.getAllCourses(), statisticsFiles);
+    }
+    if (command == "gpa") {
+        GradeScale scale = GradeScale::makeDefault();
+        std::string output = "student\tcourses\tcredits\tgpa\n";
+        for (int student = 0; student < registry.getStudentCount(); student++) {
+            const Course* first = registry.getAllCourses().data() + registry.getFirstCourse(student);
+            GpaTotals totals = GpaTracker::calculate(first, registry.getStudentCourseCount(student), scale, false, nullptr);
+            output += registry.getStudentId(student);
+            output += '\t';
+            appendGpaFields(output, totals);
+        }
+        return writeBatchOutput(output) ? 0 : 1;
+    }
+    if (command == "required-table") {
+        RequiredGradeMatrix matrix = registry.calculateRequiredGradeMatrix(goals);
+        std::string output;
+        output.reserve(8 * (goals.size() + 2) * (registry.getCourseCount() + 1));
+        output += "student\t";
+        appendRequiredTableHeader(output, goals);
+        for (int i = 0; i < registry.getCourseCount(); i++) {
+            output += registry.getStudentId(registry.getStudentOfCourse(i));
+            output += '\t';
+            output += registry.getCourse(i).getCourseCode();
+            output += '\t';
+            appendRequiredTableFields(output, matrix, i);
+        }
+        return writeBatchOutput(output) ? 0 : 1;
+    }
+
+    std::string output;
+    output.reserve(80 * (registry.getCourseCount() + 1));
+    output += "student\t";
+    output += getBatchHeader(command);
+
+    std::vector<CourseEvaluation> evaluations;
+    if (command != "whatif") {
+        evaluations = registry.evaluateAll(argument);
+    }
+
+    for (int student = 0; student < registry.getStudentCount(); student++) {
+        int end = registry.getFirstCourse(student) + registry.getStudentCourseCount(student);
+        for (int i = registry.getFirstCourse(student); i < end; i++) {
+            const Course& course = registry.getCourse(i);
+            output += registry.getStudentId(student);
+            output += '\t';
+            output += course.getCourseCode();
+            output += '\t';
+
+            if (command == "report") {
+                appendReportFields(output, evaluations[i].summary, course.getIsA5050Course(), course.getAssessmentCount());
+            } else if (command == "required") {
+                appendRequiredFields(output, argument, evaluations[i]);
+            } else {
+                appendWhatIfFields(output, course, argument);
+            }
+        }
+    }
+
+    return writeBatchOutput(output) ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    std::string filePath = "courses.json";
+    std::string studentsDirectory;
+    std::string command;
+    double argument = 0.0;
+    double goalRange[3] = {50.0, 100.0, 1.0}; // required-table FROM TO STEP
+    StatisticsFiles statisticsFiles;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--file" && i + 1 < argc) {
+            filePath = argv[++i];
+        } else if (arg == "--students" && i + 1 < argc) {
+            studentsDirectory = argv[++i];
+        } else if (arg == "--diff-redraw") {
+            terminal.setDiffRedraw(true);
+        } else if (arg == "--stats-in" && i + 1 < argc) {
+            statisticsFiles.inputs.push_back(argv[++i]);
+        } else if (arg == "--stats-out" && i + 1 < argc) {
+            statisticsFiles.output = argv[++i];
+        } else if (command.empty() && (arg == "report" || arg == "stats" || arg == "gpa")) {
+            command = arg;
+        } else if (command.empty() && (arg == "required" || arg == "whatif")) {
+            if (i + 1 >= argc || !parseNumberArgument(argv[i + 1], argument)) {
+                std::cerr << "Error: '" << arg << "' needs a numeric percentage\n";
+                printUsage(argv[0]);
+                return 2;
+            }
+            command = arg;
+            i++;
+            if (command == "whatif") {
+                argument = clampGrade(argument, std::cerr); // the same bounds as the menu's simulation
+            }
+        } else if (command.empty() && arg == "required-table") {
+            command = arg;
+            if (i + 1 < argc && parseNumberArgument(argv[i + 1], goalRange[0])) {
+                if (i + 3 >= argc || !parseNumberArgument(argv[i + 2], goalRange[1]) ||
+                    !parseNumberArgument(argv[i + 3], goalRange[2]) || goalRange[2] <= 0.0) {
+                    std::cerr << "Error: 'required-table' takes either no range or FROM TO STEP\n";
+                    printUsage(argv[0]);
+                    return 2;
+                }
+                i += 3;
+            }
+        } else {
+            std::cerr << "Error: unexpected argument '" << arg << "'\n";
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if ((!statisticsFiles.inputs.empty() || !statisticsFiles.output.empty()) && command != "stats") {
+        std::cerr << "Error: --stats-in and --stats-out only go with 'stats'\n";
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    std::vector<double> goals;
+    if (command == "required-table") {
+        goals = RequiredGradeMatrix::makeGoalRange(goalRange[0], goalRange[1], goalRange[2]);
+    }
+
+    if (!studentsDirectory.empty()) {
+        if (command.empty()) {
+            std::cerr << "Error: --students needs a command\n";
+            printUsage(argv[0]);
+            return 2;
+        }
+        return runCohortBatch(studentsDirectory, command, argument, goals, statisticsFiles);
+    }
+
+    if (!command.empty()) {
+        if (!std::filesystem::exists(filePath)) {
+            std::cerr << "Error: data file " << filePath << " does not exist\n";
+            return 1;
+        }
+        return runBatch(filePath, command, argument, goals, statisticsFiles);
+    }
+
+    // Create course manager with the chosen file path
+    CourseManager manager(filePath);
+    manager.setAutoSave(false); // edits go to the journal, the full files are written on exit
     
-    showMainMenu(manager);
+    GpaTracker gpa(manager); // follows every edit made through the menus
+    showMainMenu(manager, gpa);
+    manager.flush();
     
     return 0;
 }
\ No newline at end of file
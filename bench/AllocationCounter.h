@@ -0,0 +1,14 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+// Counts every global operator new in the process. Linking AllocationCounter.cpp
+// replaces the global allocation functions, so only the benchmark binaries use it.
+class AllocationCounter {
+public:
+    static uint64_t getCount();
+    static uint64_t getBytes();
+};
+
+#endif
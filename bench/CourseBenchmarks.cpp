@@ -0,0 +1,263 @@
+// Google Benchmark suite for the Course and CourseManager hot paths.
+// Build and run with `make bench && ./bench/course_bench`; the benchmark's own
+// flags (--benchmark_filter=Load, --benchmark_format=json, ...) all apply.
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "AllocationCounter.h"
+#include "CourseManager.h"
+#include "GradeKernels.h"
+#include "SyntheticData.h"
+
+namespace {
+
+// allocations per iteration, taken as a delta around the timed loop
+class AllocationScope {
+private:
+    benchmark::State& state;
+    uint64_t startCount;
+    uint64_t startBytes;
+
+public:
+    explicit AllocationScope(benchmark::State& state)
+        : state(state), startCount(AllocationCounter::getCount()), startBytes(AllocationCounter::getBytes()) {}
+
+    ~AllocationScope() {
+        state.counters["allocs"] = benchmark::Counter(
+            static_cast<double>(AllocationCounter::getCount() - startCount), benchmark::Counter::kAvgIterations);
+        state.counters["allocBytes"] = benchmark::Counter(
+            static_cast<double>(AllocationCounter::getBytes() - startBytes), benchmark::Counter::kAvgIterations);
+    }
+};
+
+// scratch data files, removed again when the benchmark finishes
+class DatasetFiles {
+private:
+    std::filesystem::path directory;
+
+public:
+    DatasetFiles(const DatasetShape& shape, bool withSnapshot) {
+        directory = std::filesystem::temp_directory_path() / "grade_bench";
+        std::filesystem::create_directories(directory);
+        std::filesystem::remove(getJsonPath());
+        std::filesystem::remove(getSnapshotPath());
+        std::filesystem::remove(getJournalPath());
+
+        CourseManager manager(getJsonPath());
+        manager.setAutoSave(false);
+        manager.setCompactionThreshold(shape.courseCount + 1);
+        for (const Course& course : SyntheticData::generateCourses(shape)) {
+            manager.addCourse(course);
+        }
+        manager.flush();
+
+        if (!withSnapshot) {
+            std::filesystem::remove(getSnapshotPath());
+        }
+    }
+
+    ~DatasetFiles() {
+        std::error_code error;
+        std::filesystem::remove_all(directory, error);
+    }
+
+    std::string getJsonPath() const { return (directory / "courses.json").string(); }
+    std::string getSnapshotPath() const { return (directory / "courses.snap").string(); }
+    std::string getJournalPath() const { return (directory / "courses.journal").string(); }
+};
+
+DatasetShape makeShape(int courseCount, int assessmentsPerCourse, int nameLength, int completionPercent) {
+    DatasetShape shape;
+    shape.courseCount = courseCount;
+    shape.assessmentsPerCourse = assessmentsPerCourse;
+    shape.nameLength = nameLength;
+    shape.completionRatio = completionPercent / 100.0;
+    return shape;
+}
+
+// Course queries; args are assessments per course and completion percent
+
+void BM_CalculateOverallGrade(benchmark::State& state) {
+    std::vector<Course> courses = SyntheticData::generateCourses(
+        makeShape(256, static_cast<int>(state.range(0)), 12, static_cast<int>(state.range(1))));
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        for (const Course& course : courses) {
+            benchmark::DoNotOptimize(course.calculateOverallGrade(true));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * courses.size());
+}
+BENCHMARK(BM_CalculateOverallGrade)->ArgsProduct({{4, 16, 64}, {0, 50, 100}});
+
+void BM_CalculateSummary(benchmark::State& state) {
+    std::vector<Course> courses = SyntheticData::generateCourses(
+        makeShape(256, static_cast<int>(state.range(0)), 12, static_cast<int>(state.range(1))));
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        for (const Course& course : courses) {
+            benchmark::DoNotOptimize(course.calculateSummary(true));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * courses.size());
+}
+BENCHMARK(BM_CalculateSummary)->ArgsProduct({{4, 16, 64}, {0, 50, 100}});
+
+void BM_CalculateRequiredGrades(benchmark::State& state) {
+    std::vector<Course> courses = SyntheticData::generateCourses(
+        makeShape(64, static_cast<int>(state.range(0)), 12, static_cast<int>(state.range(1))));
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        for (const Course& course : courses) {
+            bool isAchievable;
+            benchmark::DoNotOptimize(course.calculateRequiredGrades(75.0, isAchievable));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * courses.size());
+}
+BENCHMARK(BM_CalculateRequiredGrades)->ArgsProduct({{4, 16, 64}, {0, 50, 100}});
+
+void BM_CalculateRequiredUniformGrade(benchmark::State& state) {
+    std::vector<Course> courses = SyntheticData::generateCourses(
+        makeShape(256, static_cast<int>(state.range(0)), 12, static_cast<int>(state.range(1))));
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        for (const Course& course : courses) {
+            bool isAchievable;
+            benchmark::DoNotOptimize(course.calculateRequiredUniformGrade(75.0, isAchievable));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * courses.size());
+}
+BENCHMARK(BM_CalculateRequiredUniformGrade)->ArgsProduct({{4, 16, 64}, {0, 50, 100}});
+
+// Goals 50..100 in 1% steps for every course in one call; items are course-goal
+// pairs, comparable with BM_CalculateRequiredUniformGrade's single goal per course.
+void BM_CalculateRequiredGradeMatrix(benchmark::State& state) {
+    std::vector<Course> courses = SyntheticData::generateCourses(
+        makeShape(256, static_cast<int>(state.range(0)), 12, static_cast<int>(state.range(1))));
+    std::vector<double> goals = RequiredGradeMatrix::makeGoalRange(50.0, 100.0, 1.0);
+    RequiredGradeMatrix matrix(goals, static_cast<int>(courses.size()));
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        for (size_t i = 0; i < courses.size(); i++) {
+            int row = static_cast<int>(i);
+            courses[i].calculateRequiredUniformGrades(matrix.goals, matrix.getRow(row), matrix.getAchievableRow(row));
+        }
+        benchmark::DoNotOptimize(matrix.requiredGrades.data());
+    }
+    state.SetItemsProcessed(state.iterations() * courses.size() * goals.size());
+}
+BENCHMARK(BM_CalculateRequiredGradeMatrix)->ArgsProduct({{4, 16, 64}, {0, 50, 100}});
+
+// Masked bucket sums; args are the kernel (0 scalar, 1 SSE2, 2 AVX2) and the
+// element count. Bytes are the weight and grade columns read, so large counts
+// can be compared with the machine's memory bandwidth.
+void BM_SumBuckets(benchmark::State& state) {
+    GradeKernels::Implementation implementation = static_cast<GradeKernels::Implementation>(state.range(0));
+    if (!GradeKernels::isSupported(implementation)) {
+        state.SkipWithError("not supported on this CPU");
+        return;
+    }
+    state.SetLabel(GradeKernels::getName(implementation));
+
+    size_t count = static_cast<size_t>(state.range(1));
+    std::vector<double> weights(count, 12.5);
+    std::vector<double> grades(count);
+    std::vector<uint64_t> theoryMask((count + 63) / 64, 0x5555555555555555ULL);
+    std::vector<uint64_t> completeMask((count + 63) / 64, 0x0f0f0f0f0f0f0f0fULL);
+    for (size_t i = 0; i < count; i++) {
+        grades[i] = static_cast<double>(i % 101);
+    }
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        BucketSums sums;
+        GradeKernels::sumBuckets(implementation, weights.data(), grades.data(), theoryMask.data(),
+                                 completeMask.data(), count, sums);
+        benchmark::DoNotOptimize(sums);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetBytesProcessed(state.iterations() * count * 2 * sizeof(double));
+}
+BENCHMARK(BM_SumBuckets)->ArgsProduct({{0, 1, 2}, {16, 1024, 1 << 16, 1 << 23}});
+
+// CourseManager persistence; args are course count and assessment name length
+
+void BM_LoadFromJson(benchmark::State& state) {
+    DatasetFiles files(makeShape(static_cast<int>(state.range(0)), 8, static_cast<int>(state.range(1)), 50), false);
+    uintmax_t fileBytes = std::filesystem::file_size(files.getJsonPath());
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        CourseManager manager(files.getJsonPath(), true);
+        benchmark::DoNotOptimize(manager.getCourseCount());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * fileBytes);
+}
+BENCHMARK(BM_LoadFromJson)->ArgsProduct({{100, 1000, 10000}, {8, 64}})->Unit(benchmark::kMillisecond);
+
+void BM_LoadFromSnapshot(benchmark::State& state) {
+    DatasetFiles files(makeShape(static_cast<int>(state.range(0)), 8, static_cast<int>(state.range(1)), 50), true);
+    uintmax_t fileBytes = std::filesystem::file_size(files.getSnapshotPath());
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        CourseManager manager(files.getJsonPath()); // owning load, every course materialised
+        benchmark::DoNotOptimize(manager.getCourseCount());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * fileBytes);
+}
+BENCHMARK(BM_LoadFromSnapshot)->ArgsProduct({{100, 1000, 10000}, {8, 64}})->Unit(benchmark::kMillisecond);
+
+void BM_LoadMapped(benchmark::State& state) {
+    DatasetFiles files(makeShape(static_cast<int>(state.range(0)), 8, static_cast<int>(state.range(1)), 50), true);
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        CourseManager manager(files.getJsonPath(), true);
+        benchmark::DoNotOptimize(manager.getCourseCount());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LoadMapped)->ArgsProduct({{100, 1000, 10000}, {8, 64}})->Unit(benchmark::kMillisecond);
+
+void BM_SaveToFile(benchmark::State& state) {
+    DatasetFiles files(makeShape(static_cast<int>(state.range(0)), 8, static_cast<int>(state.range(1)), 50), true);
+    CourseManager manager(files.getJsonPath());
+    manager.setAutoSave(false);
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.saveToFile());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() *
+        (std::filesystem::file_size(files.getJsonPath()) + std::filesystem::file_size(files.getSnapshotPath())));
+}
+BENCHMARK(BM_SaveToFile)->ArgsProduct({{100, 1000, 10000}, {8, 64}})->Unit(benchmark::kMillisecond);
+
+void BM_EvaluateAll(benchmark::State& state) {
+    DatasetFiles files(makeShape(static_cast<int>(state.range(0)), 8, 12, 50), true);
+    CourseManager manager(files.getJsonPath());
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.evaluateAll(75.0, static_cast<unsigned>(state.range(1))));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EvaluateAll)->ArgsProduct({{1000, 20000}, {1, 4, 0}})->UseRealTime();
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,142 @@
+// Writes a synthetic course file of any size for load testing, as JSON, as a
+// binary snapshot beside it, or both. The snapshot is written last so that
+// CourseManager treats it as current.
+//
+//   ./bench/generate_dataset --out big.json --courses 100000 --assessments 10
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "CourseSnapshot.h"
+#include "SyntheticData.h"
+
+using json = nlohmann::json;
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " --out FILE [options]\n"
+              << "  --courses N          number of courses (default 1000)\n"
+              << "  --assessments N      assessments per course (default 8)\n"
+              << "  --spread N           vary assessments per course by +-N (default 2)\n"
+              << "  --name-length N      characters per assessment name (default 12)\n"
+              << "  --completion R       fraction of assessments graded, 0..1 (default 0.5)\n"
+              << "  --fifty-fifty R      fraction of 50/50 courses, 0..1 (default 0.3)\n"
+              << "  --lab R              fraction of lab work in regular courses (default 0.25)\n"
+              << "  --seed N             random seed (default 42)\n"
+              << "  --format F           json, snapshot or both (default both)\n";
+}
+
+// one course object per line, the whole file is never held as a JSON DOM
+bool writeJson(const std::string& filePath, const std::vector<Course>& courses) {
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        std::cerr << "Error: could not write " << filePath << std::endl;
+        return false;
+    }
+
+    file << "{\n\"revision\": 0,\n\"courses\": [\n";
+    for (size_t i = 0; i < courses.size(); i++) {
+        const Course& course = courses[i];
+        json courseJson;
+        courseJson["courseCode"] = course.getCourseCode();
+        courseJson["isA5050Course"] = course.getIsA5050Course();
+        courseJson["assessments"] = json::array();
+        for (const AssessmentView& assessment : course.getAssessments()) {
+            courseJson["assessments"].push_back({
+                {"name", assessment.getName()},
+                {"weight", assessment.getWeight()},
+                {"grade", assessment.getGrade()},
+                {"isTheory", assessment.getIsTheory()},
+                {"isComplete", assessment.getIsComplete()}
+            });
+        }
+        file << courseJson.dump() << (i + 1 < courses.size() ? ",\n" : "\n");
+    }
+    file << "]\n}\n";
+
+    file.close();
+    return file.good();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    DatasetShape shape;
+    shape.courseCount = 1000;
+    shape.assessmentsSpread = 2;
+    std::string outPath;
+    std::string format = "both";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else if (arg == "--courses" && hasValue) {
+            shape.courseCount = std::atoi(argv[++i]);
+        } else if (arg == "--assessments" && hasValue) {
+            shape.assessmentsPerCourse = std::atoi(argv[++i]);
+        } else if (arg == "--spread" && hasValue) {
+            shape.assessmentsSpread = std::atoi(argv[++i]);
+        } else if (arg == "--name-length" && hasValue) {
+            shape.nameLength = std::atoi(argv[++i]);
+        } else if (arg == "--completion" && hasValue) {
+            shape.completionRatio = std::atof(argv[++i]);
+        } else if (arg == "--fifty-fifty" && hasValue) {
+            shape.fiftyFiftyRatio = std::atof(argv[++i]);
+        } else if (arg == "--lab" && hasValue) {
+            shape.labRatio = std::atof(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            shape.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--format" && hasValue) {
+            format = argv[++i];
+        } else {
+            std::cerr << "Error: unexpected argument '" << arg << "'\n";
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (outPath.empty() || shape.courseCount < 0 ||
+        (format != "json" && format != "snapshot" && format != "both")) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Course> courses = SyntheticData::generateCourses(shape);
+
+    size_t assessmentCount = 0;
+    for (const Course& course : courses) {
+        assessmentCount += course.getAssessmentCount();
+    }
+
+    std::filesystem::path parent = std::filesystem::path(outPath).parent_path();
+    if (!parent.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(parent, error);
+    }
+
+    if (format != "snapshot" && !writeJson(outPath, courses)) {
+        return 1;
+    }
+    if (format != "json") {
+        std::string snapshotPath = std::filesystem::path(outPath).replace_extension(".snap").string();
+        if (!CourseSnapshot::save(snapshotPath, courses, 0)) {
+            return 1;
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Wrote " << courses.size() << " courses, " << assessmentCount << " assessments in "
+              << elapsed.count() << " s\n";
+    return 0;
+}
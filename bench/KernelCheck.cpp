@@ -0,0 +1,106 @@
+// Cross-check of GradeKernels: every implementation the CPU supports against the
+// scalar one, on random columns of every length up to a few mask words, with
+// random bits past the end of the masks. Weights and grades are whole numbers, so
+// every partial sum is exact and the lane order can't matter: bucket sums and
+// counts have to agree bit for bit.
+//
+//   ./bench/kernel_check [--rounds N]
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "GradeKernels.h"
+
+namespace {
+
+bool sameSums(const BucketSums& a, const BucketSums& b) {
+    return std::memcmp(a.weightedGrade, b.weightedGrade, sizeof(a.weightedGrade)) == 0 &&
+           std::memcmp(a.weight, b.weight, sizeof(a.weight)) == 0 &&
+           std::memcmp(a.count, b.count, sizeof(a.count)) == 0;
+}
+
+std::vector<size_t> getLengths() {
+    std::vector<size_t> lengths;
+    for (size_t length = 0; length <= 17; length++) {
+        lengths.push_back(length);
+    }
+    // either side of the whole-word loop
+    for (size_t length : {63, 64, 65, 127, 128, 130}) {
+        lengths.push_back(length);
+    }
+    return lengths;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = 200;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--rounds" && i + 1 < argc) {
+            rounds = std::atoi(argv[++i]);
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--rounds N]\n";
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+
+    using Implementation = GradeKernels::Implementation;
+    std::vector<Implementation> implementations;
+    for (Implementation implementation : {Implementation::Sse2, Implementation::Avx2}) {
+        if (GradeKernels::isSupported(implementation)) {
+            implementations.push_back(implementation);
+        }
+    }
+
+    std::mt19937_64 random(12345);
+    std::uniform_int_distribution<int> percent(0, 100);
+    int failures = 0;
+    int cases = 0;
+    for (size_t length : getLengths()) {
+        for (int round = 0; round < rounds; round++) {
+            // exactly sized, so a read past the end shows up under a sanitizer
+            std::vector<double> weights(length);
+            std::vector<double> grades(length);
+            std::vector<uint64_t> theoryMask(length / 64 + 1);
+            std::vector<uint64_t> completeMask(length / 64 + 1);
+            for (size_t i = 0; i < length; i++) {
+                weights[i] = percent(random);
+                grades[i] = percent(random);
+            }
+            for (size_t word = 0; word < theoryMask.size(); word++) {
+                theoryMask[word] = random();
+                completeMask[word] = random();
+            }
+
+            BucketSums expected;
+            GradeKernels::sumBuckets(Implementation::Scalar, weights.data(), grades.data(), theoryMask.data(),
+                                     completeMask.data(), length, expected);
+            for (Implementation implementation : implementations) {
+                BucketSums actual;
+                GradeKernels::sumBuckets(implementation, weights.data(), grades.data(), theoryMask.data(),
+                                         completeMask.data(), length, actual);
+                cases++;
+                if (!sameSums(actual, expected)) {
+                    std::cerr << "FAILED: " << GradeKernels::getName(implementation) << " differs from scalar at length "
+                              << length << ", round " << round << std::endl;
+                    failures++;
+                }
+            }
+        }
+    }
+
+    if (failures > 0) {
+        std::cerr << failures << " of " << cases << " kernel checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "kernel checks passed (" << cases << " cases against scalar:";
+    for (Implementation implementation : implementations) {
+        std::cout << ' ' << GradeKernels::getName(implementation);
+    }
+    std::cout << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,154 @@
+// Load-test harness: loads a course file, queries and edits every course, saves
+// it, and prints the wall time and peak resident set size after each phase as
+// tab-separated values. Pair it with generate_dataset for a scaling curve, see
+// bench/scaling.sh.
+//
+//   ./bench/load_test --file big.json [--mapped] [--goal 75] [--compact-every N] [--no-save]
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <iostream>
+#include <string>
+#include "CourseManager.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+namespace {
+
+// peak resident set size of this process so far, in KiB
+long getPeakRssKiB() {
+    #ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return 0;
+        }
+        return static_cast<long>(counters.PeakWorkingSetSize / 1024);
+    #else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+        return usage.ru_maxrss; // already KiB on Linux
+    #endif
+}
+
+void runPhase(const std::string& name, const std::function<void()>& phase) {
+    auto start = std::chrono::steady_clock::now();
+    phase();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << "\t" << elapsed.count() << "\t" << getPeakRssKiB() << std::endl;
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " --file FILE [options]\n"
+              << "  --mapped     load read-only, mapping the snapshot when it is current\n"
+              << "  --goal G     target grade for the required-grade phases (default 75)\n"
+              << "  --compact-every N  full save after N journaled edits (default: only in the save phase)\n"
+              << "  --no-save    skip the edit and save phases and leave the files alone\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string filePath;
+    bool mapped = false;
+    bool save = true;
+    double goal = 75.0;
+    int compactEvery = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--file" && i + 1 < argc) {
+            filePath = argv[++i];
+        } else if (arg == "--goal" && i + 1 < argc) {
+            goal = std::atof(argv[++i]);
+        } else if (arg == "--compact-every" && i + 1 < argc) {
+            compactEvery = std::atoi(argv[++i]);
+        } else if (arg == "--mapped") {
+            mapped = true;
+        } else if (arg == "--no-save") {
+            save = false;
+        } else {
+            std::cerr << "Error: unexpected argument '" << arg << "'\n";
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (filePath.empty()) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    // a read-only manager never saves, whatever the flags say
+    save = save && !mapped;
+
+    std::cout << "phase\tseconds\tpeakRssKiB" << std::endl;
+    runPhase("start", []() {});
+
+    std::unique_ptr<CourseManager> manager;
+    runPhase("load", [&]() {
+        manager.reset(new CourseManager(filePath, mapped));
+        manager->setAutoSave(false);
+    });
+
+    int courseCount = manager->getCourseCount();
+    manager->setCompactionThreshold(compactEvery > 0 ? compactEvery : courseCount + 1);
+    double checksum = 0.0; // keeps the query phases from being optimised away
+
+    runPhase("summaries", [&]() {
+        for (int i = 0; i < courseCount; i++) {
+            GradeSummary summary;
+            if (manager->getCourseSummary(i, true, summary)) {
+                checksum += summary.gradeSoFar;
+            }
+        }
+    });
+
+    runPhase("evaluateAll", [&]() {
+        std::vector<CourseEvaluation> results = manager->evaluateAll(goal);
+        for (const CourseEvaluation& result : results) {
+            checksum += result.requiredGrade;
+        }
+    });
+
+    runPhase("requiredGrades", [&]() {
+        // materialises every course first when the snapshot is mapped
+        for (const Course& course : manager->getAllCourses()) {
+            checksum += course.calculateRequiredGrades(goal).size();
+        }
+    });
+
+    if (save) {
+        // rewrite one grade per course with its current value: the journal and
+        // save costs are real, the data is unchanged for the next run
+        runPhase("edits", [&]() {
+            for (int i = 0; i < courseCount; i++) {
+                const Course& course = manager->getCourse(i);
+                if (course.getAssessmentCount() > 0) {
+                    manager->updateAssessmentGrade(i, 0, course.getAssessment(0).getGrade());
+                }
+            }
+        });
+
+        runPhase("save", [&]() {
+            manager->saveToFile();
+        });
+    }
+
+    runPhase("unload", [&]() {
+        manager.reset();
+    });
+
+    std::cerr << "courses " << courseCount << ", checksum " << checksum << std::endl;
+    return 0;
+}
@@ -0,0 +1,373 @@
+// Round-trip checks for the on-disk formats: writes snapshots and journals, reads
+// them back (also in the older layouts the readers still accept, and with torn or
+// corrupt journal tails) and compares field by field, then loads a student
+// directory through StudentRegistry with an edit left in the journal and
+// round-trips saved cohort statistics.
+// Prints one line per failed check and exits non-zero if there was any.
+//
+//   ./bench/persistence_check [--dir DIR]
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "CohortStatistics.h"
+#include "Course.h"
+#include "CourseSnapshot.h"
+#include "EditJournal.h"
+#include "MappedSnapshot.h"
+#include "StudentRegistry.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::string& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), bytes.size());
+}
+
+std::vector<Course> makeCourses() {
+    std::vector<Course> courses;
+    courses.emplace_back("MTH 140", std::vector<Assessment>{Assessment("Midterm", 30, 81.5, true, true),
+                                                            Assessment("Final", 50, 0, true, false),
+                                                            Assessment("Lab 1", 20, 92, false, true)}, true);
+    courses.back().setCredits(3);
+    courses.back().setTerm("2025-09");
+    courses.emplace_back("CPS 109", std::vector<Assessment>{Assessment("Final", 100, 64.25, true, true)}, false);
+    courses.back().setCredits(0.5);
+    courses.emplace_back("EMPTY", std::vector<Assessment>{}, false);
+    courses.back().setTerm("2026-01");
+    return courses;
+}
+
+// compares everything but credits and term, which older formats don't carry
+bool sameAssessments(const Course& a, const Course& b) {
+    if (a.getCourseCode() != b.getCourseCode() || a.getIsA5050Course() != b.getIsA5050Course() ||
+        a.getAssessmentCount() != b.getAssessmentCount()) {
+        return false;
+    }
+    for (int i = 0; i < a.getAssessmentCount(); i++) {
+        Assessment x = a.getAssessment(i);
+        Assessment y = b.getAssessment(i);
+        if (x.getName() != y.getName() || x.getWeight() != y.getWeight() || x.getGrade() != y.getGrade() ||
+            x.getIsTheory() != y.getIsTheory() || x.getIsComplete() != y.getIsComplete()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Rewrites a current snapshot in the layout of an older version: 24-byte course
+// records ending in a reserved word, and for version 1 no revision in the header.
+std::string downgradeSnapshot(const std::string& current, uint32_t version) {
+    uint32_t courseCount;
+    std::memcpy(&courseCount, current.data() + 12, sizeof(courseCount));
+    size_t headerSize = version == 1 ? 32 : 40;
+
+    std::string result = current.substr(0, headerSize);
+    std::memcpy(&result[8], &version, sizeof(version));
+    for (uint32_t i = 0; i < courseCount; i++) {
+        result += current.substr(40 + i * 32, 20);
+        result.append(4, '\0');
+    }
+    result += current.substr(40 + size_t(courseCount) * 32);
+    return result;
+}
+
+void checkSnapshot(const std::string& path, uint32_t version, const std::vector<Course>& expected,
+                   uint64_t expectedRevision) {
+    std::string label = "snapshot v" + std::to_string(version) + ": ";
+    bool isCurrent = version == CourseSnapshot::version;
+
+    std::vector<Course> loaded;
+    uint64_t revision = 99;
+    check(CourseSnapshot::load(path, loaded, revision), label + "load");
+    check(revision == expectedRevision, label + "revision");
+    check(loaded.size() == expected.size(), label + "course count");
+    for (size_t i = 0; i < loaded.size() && i < expected.size(); i++) {
+        std::string course = label + expected[i].getCourseCode() + " ";
+        check(sameAssessments(loaded[i], expected[i]), course + "assessments");
+        check(loaded[i].getCredits() == (isCurrent ? expected[i].getCredits() : Course::defaultCredits),
+              course + "credits");
+        check(loaded[i].getTerm() == (isCurrent ? expected[i].getTerm() : std::string()), course + "term");
+    }
+
+    MappedSnapshot mapping;
+    check(mapping.open(path), label + "map");
+    check(mapping.getCourseCount() == static_cast<int>(expected.size()), label + "mapped course count");
+    for (int i = 0; i < mapping.getCourseCount() && i < static_cast<int>(loaded.size()); i++) {
+        MappedCourseView view = mapping.getCourse(i);
+        check(sameAssessments(view.toCourse(), loaded[i]), label + "mapped course " + std::to_string(i));
+        check(view.getCredits() == loaded[i].getCredits() && view.getTerm() == loaded[i].getTerm(),
+              label + "mapped credits and term " + std::to_string(i));
+    }
+}
+
+void checkSnapshots(const std::filesystem::path& directory) {
+    std::vector<Course> courses = makeCourses();
+    std::string path = (directory / "courses.snap").string();
+    check(CourseSnapshot::save(path, courses, 42), "snapshot: save");
+    std::string current = readFile(path);
+    checkSnapshot(path, CourseSnapshot::version, courses, 42);
+
+    writeFile(path, downgradeSnapshot(current, 2));
+    checkSnapshot(path, 2, courses, 42);
+    writeFile(path, downgradeSnapshot(current, 1));
+    checkSnapshot(path, 1, courses, 0);
+
+    // a cut-off file is refused rather than read past its end
+    writeFile(path, current.substr(0, current.size() - 1));
+    std::vector<Course> loaded;
+    uint64_t revision;
+    check(!CourseSnapshot::load(path, loaded, revision), "snapshot: truncated file rejected");
+}
+
+// the journal's frame checksum (FNV-1a over sequence, type and payload)
+uint32_t frameChecksum(const char* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+std::vector<JournalRecord> replayAll(EditJournal& journal, uint64_t afterSequence, bool trimTornTail) {
+    std::vector<JournalRecord> records;
+    journal.replay(afterSequence, trimTornTail, [&records](const JournalRecord& record) {
+        records.push_back(record);
+    });
+    return records;
+}
+
+std::vector<JournalRecord> makeRecords() {
+    using Type = JournalRecord::Type;
+    std::vector<JournalRecord> records(5);
+    records[0].type = Type::AddCourse;
+    records[0].text = "MTH 140";
+    records[0].flag = true;
+    records[0].number = 3;
+    records[0].term = "2025-09";
+    records[0].assessments = {Assessment("Midterm", 40, 77.5, true, true), Assessment("Lab", 60, 0, false, false)};
+    records[1].type = Type::UpdateAssessmentGrade;
+    records[1].courseIndex = 0;
+    records[1].assessmentIndex = 1;
+    records[1].number = 88.25;
+    records[2].type = Type::SetCourseCredits;
+    records[2].courseIndex = 0;
+    records[2].number = 0.5;
+    records[3].type = Type::SetCourseTerm;
+    records[3].courseIndex = 0;
+    records[3].text = "2026-01";
+    records[4].type = Type::UpdateAssessmentName;
+    records[4].courseIndex = 0;
+    records[4].assessmentIndex = 0;
+    records[4].text = "Midterm (rewritten)";
+    for (size_t i = 0; i < records.size(); i++) {
+        records[i].sequence = i + 1;
+    }
+    return records;
+}
+
+bool sameRecord(const JournalRecord& a, const JournalRecord& b) {
+    if (a.type != b.type || a.sequence != b.sequence || a.courseIndex != b.courseIndex ||
+        a.assessmentIndex != b.assessmentIndex || a.text != b.text || a.term != b.term ||
+        a.number != b.number || a.flag != b.flag || a.assessments.size() != b.assessments.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.assessments.size(); i++) {
+        const Assessment& x = a.assessments[i];
+        const Assessment& y = b.assessments[i];
+        if (x.getName() != y.getName() || x.getWeight() != y.getWeight() || x.getGrade() != y.getGrade() ||
+            x.getIsTheory() != y.getIsTheory() || x.getIsComplete() != y.getIsComplete()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameRecords(const std::vector<JournalRecord>& replayed, const std::vector<JournalRecord>& expected,
+                 size_t first, size_t count) {
+    if (replayed.size() != count) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!sameRecord(replayed[i], expected[first + i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void checkJournal(const std::filesystem::path& directory) {
+    std::string path = (directory / "courses.journal").string();
+    std::vector<JournalRecord> records = makeRecords();
+
+    // frameEnds[i] is the file size once record i is written
+    std::vector<uintmax_t> frameEnds;
+    {
+        EditJournal journal(path);
+        check(journal.reset(), "journal: reset");
+        for (const JournalRecord& record : records) {
+            check(journal.append(record), "journal: append");
+            frameEnds.push_back(std::filesystem::file_size(path));
+        }
+    }
+    std::string intact = readFile(path);
+
+    EditJournal journal(path);
+    check(sameRecords(replayAll(journal, 0, true), records, 0, records.size()), "journal: replay all records");
+    check(sameRecords(replayAll(journal, 2, true), records, 2, records.size() - 2), "journal: replay after a sequence");
+
+    // a write cut off halfway through the last frame
+    uintmax_t lastStart = frameEnds[frameEnds.size() - 2];
+    writeFile(path, intact.substr(0, lastStart + (frameEnds.back() - lastStart) / 2));
+    check(sameRecords(replayAll(journal, 0, false), records, 0, records.size() - 1),
+          "journal: torn tail skipped");
+    check(std::filesystem::file_size(path) > lastStart, "journal: torn tail kept without trimTornTail");
+    check(sameRecords(replayAll(journal, 0, true), records, 0, records.size() - 1),
+          "journal: torn tail skipped when trimming");
+    check(std::filesystem::file_size(path) == lastStart, "journal: torn tail trimmed");
+
+    // appending after the trim continues from a clean frame boundary
+    check(journal.append(records.back()), "journal: append after trim");
+    check(sameRecords(replayAll(journal, 0, true), records, 0, records.size()), "journal: replay after re-append");
+
+    // a flipped payload byte fails the checksum; replay stops before that record
+    std::string corrupt = intact;
+    corrupt[frameEnds[1] + 14] ^= 0x40;
+    writeFile(path, corrupt);
+    check(sameRecords(replayAll(journal, 0, false), records, 0, 2), "journal: corrupt record rejected");
+
+    // An AddCourse written before credits and terms existed: the same frame with
+    // the trailing credits and empty-term length cut off and the frame redone.
+    JournalRecord oldCourse = records[0];
+    oldCourse.term.clear();
+    {
+        EditJournal writer(path);
+        writer.reset();
+        writer.append(oldCourse);
+    }
+    std::string frame = readFile(path);
+    uint32_t payloadSize;
+    std::memcpy(&payloadSize, frame.data(), sizeof(payloadSize));
+    payloadSize -= sizeof(double) + sizeof(uint32_t);
+    std::string oldFrame = frame.substr(0, 13 + payloadSize);
+    std::memcpy(&oldFrame[0], &payloadSize, sizeof(payloadSize));
+    uint32_t oldChecksum = frameChecksum(oldFrame.data() + 4, oldFrame.size() - 4);
+    oldFrame.append(reinterpret_cast<const char*>(&oldChecksum), sizeof(oldChecksum));
+    writeFile(path, oldFrame);
+
+    oldCourse.number = Course::defaultCredits;
+    std::vector<JournalRecord> replayed = replayAll(journal, 0, true);
+    check(replayed.size() == 1 && sameRecord(replayed[0], oldCourse), "journal: pre-credits AddCourse record");
+}
+
+// A student's edits still in the journal count in the registry, and loading it
+// leaves the student's files alone.
+void checkRegistry(const std::filesystem::path& directory) {
+    std::filesystem::path students = directory / "students";
+    std::filesystem::create_directories(students);
+    std::string path = (students / "alice.json").string();
+    {
+        CourseManager manager(path);
+        for (const Course& course : makeCourses()) {
+            manager.addCourse(course);
+        }
+        check(manager.saveToFile(), "registry: save");
+    }
+    // never destroyed, so the edit is only in the journal, as after a crash
+    CourseManager* crashed = new CourseManager(path);
+    crashed->setCourseCode(0, "EDITED");
+    std::string journalBytes = readFile((students / "alice.journal").string());
+    check(!journalBytes.empty(), "registry: edit journaled");
+    writeFile((students / "bob.json").string(), "{\"courses\": [");
+
+    StudentRegistry registry;
+    std::streambuf* errors = std::cerr.rdbuf(nullptr); // bob's load errors are expected
+    bool allLoaded = registry.loadDirectory(students.string(), 2);
+    std::cerr.rdbuf(errors);
+    std::cerr.clear();
+    check(!allLoaded, "registry: malformed student reported");
+    check(registry.getStudentCount() == 1 && registry.findStudent("alice") == 0, "registry: students loaded");
+    const Course* edited = registry.findCourse("alice", "EDITED");
+    check(edited && registry.getStudentCourseCount(0) == static_cast<int>(makeCourses().size()),
+          "registry: journaled edit replayed");
+    check(readFile((students / "alice.journal").string()) == journalBytes, "registry: journal untouched");
+}
+
+// Saved statistics read back the same, assessment groups found by name, and
+// merging a loaded shard matches merging the one it was saved from.
+void checkStatistics(const std::filesystem::path& directory) {
+    std::vector<Course> courses = makeCourses();
+    CohortStatistics first = CohortStatistics::compute(courses, 1);
+    CohortStatistics second = CohortStatistics::compute({courses[0]}, 1);
+
+    std::string path = (directory / "shard.stat").string();
+    check(second.save(path), "statistics: save");
+    CohortStatistics loaded;
+    check(loaded.load(path), "statistics: load");
+    check(loaded.serialize() == second.serialize(), "statistics: round trip");
+    const GradeStatistics* midterm = loaded.getAssessmentStatistics("Midterm");
+    check(midterm && midterm->getCount() == 1 && midterm->getMean() == 81.5, "statistics: assessment by name");
+
+    CohortStatistics mergedLoaded = first;
+    mergedLoaded.merge(loaded);
+    CohortStatistics mergedOriginal = first;
+    mergedOriginal.merge(second);
+    check(mergedLoaded.serialize() == mergedOriginal.serialize(), "statistics: merge of a loaded shard");
+
+    std::string bytes = second.serialize();
+    CohortStatistics rejected = first;
+    check(!rejected.deserialize(std::string_view(bytes).substr(0, bytes.size() - 1)),
+          "statistics: truncated bytes rejected");
+    check(!rejected.deserialize(bytes + '\0'), "statistics: trailing bytes rejected");
+    bytes[12] ^= 1; // after magic and version: allCourses' count, now off from its histogram
+    check(!rejected.deserialize(bytes), "statistics: inconsistent counts rejected");
+    check(rejected.serialize() == first.serialize(), "statistics: rejected bytes change nothing");
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "grade_persistence_check";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--dir" && i + 1 < argc) {
+            directory = argv[++i];
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--dir DIR]\n";
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    checkSnapshots(directory);
+    checkJournal(directory);
+    checkRegistry(directory);
+    checkStatistics(directory);
+
+    std::filesystem::remove_all(directory);
+    if (failures > 0) {
+        std::cerr << failures << " persistence checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "persistence checks passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include "SyntheticData.h"
+#include <random>
+
+std::vector<Course> SyntheticData::generateCourses(const DatasetShape& shape) {
+    std::vector<Course> courses;
+    courses.reserve(shape.courseCount);
+    for (int i = 0; i < shape.courseCount; i++) {
+        courses.push_back(generateCourse(shape, i));
+    }
+    return courses;
+}
+
+Course SyntheticData::generateCourse(const DatasetShape& shape, int courseNumber) {
+    // seeded per course so a single course can be regenerated on its own
+    std::mt19937 random(shape.seed ^ (static_cast<uint32_t>(courseNumber) * 2654435761u));
+    std::uniform_real_distribution<double> gradeDistribution(40.0, 100.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    bool isA5050Course = unit(random) < shape.fiftyFiftyRatio;
+    int count = shape.assessmentsPerCourse;
+    if (shape.assessmentsSpread > 0) {
+        count += std::uniform_int_distribution<int>(-shape.assessmentsSpread, shape.assessmentsSpread)(random);
+    }
+    count = count > 0 ? count : 1;
+    int completeCount = static_cast<int>(count * shape.completionRatio + 0.5);
+    double weight = 100.0 / count;
+
+    std::vector<Assessment> assessments;
+    assessments.reserve(count);
+    for (int i = 0; i < count; i++) {
+        std::string name = "Assessment " + std::to_string(i + 1);
+        if (static_cast<int>(name.size()) < shape.nameLength) {
+            name.append(shape.nameLength - name.size(), static_cast<char>('a' + i % 26));
+        } else {
+            name.resize(shape.nameLength > 0 ? shape.nameLength : 1);
+        }
+
+        bool isComplete = i < completeCount;
+        bool isTheory = isA5050Course ? i % 2 == 0 : unit(random) >= shape.labRatio;
+        double grade = isComplete ? gradeDistribution(random) : 0.0;
+        assessments.emplace_back(name, weight, grade, isTheory, isComplete);
+    }
+
+    return Course("SYN" + std::to_string(courseNumber + 100), std::move(assessments), isA5050Course);
+}
@@ -0,0 +1,28 @@
+#ifndef SYNTHETIC_DATA_H
+#define SYNTHETIC_DATA_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Course.h"
+
+// Shape of a generated data set. The same shape and seed always produce the
+// same courses, so benchmark runs on different builds compare like with like.
+struct DatasetShape {
+    int courseCount = 100;
+    int assessmentsPerCourse = 8;
+    int assessmentsSpread = 0;     // each course gets assessmentsPerCourse +- this many
+    int nameLength = 12;           // characters per assessment name
+    double completionRatio = 0.5;  // fraction of assessments already graded
+    double fiftyFiftyRatio = 0.3;  // fraction of 50/50 courses
+    double labRatio = 0.25;        // fraction of lab assessments in regular courses
+    uint32_t seed = 42;
+};
+
+class SyntheticData {
+public:
+    static std::vector<Course> generateCourses(const DatasetShape& shape);
+    static Course generateCourse(const DatasetShape& shape, int courseNumber);
+};
+
+#endif
@@ -0,0 +1,26 @@
+#!/bin/sh
+# Scaling curve: generate data sets from 10^5 to 10^7 assessments and run the
+# load test on each, once through JSON and once through the mapped snapshot.
+# Usage: bench/scaling.sh [work-dir]   (run `make tools` first)
+set -e
+
+WORK_DIR=${1:-/tmp/grade_scaling}
+BIN_DIR=$(dirname "$0")
+mkdir -p "$WORK_DIR"
+
+printf 'assessments\tmode\tphase\tseconds\tpeakRssKiB\n'
+for COURSES in 10000 100000 1000000; do
+    FILE="$WORK_DIR/courses_$COURSES.json"
+    SNAPSHOT="$WORK_DIR/courses_$COURSES.snap"
+    ASSESSMENTS=$((COURSES * 10))
+    "$BIN_DIR/generate_dataset" --out "$FILE" --courses "$COURSES" --assessments 10 >&2
+
+    # JSON only: hide the snapshot so the first load has to parse
+    mv "$SNAPSHOT" "$SNAPSHOT.keep"
+    "$BIN_DIR/load_test" --file "$FILE" --no-save | tail -n +2 | sed "s/^/$ASSESSMENTS\tjson\t/"
+    mv "$SNAPSHOT.keep" "$SNAPSHOT"
+    touch "$SNAPSHOT"
+
+    "$BIN_DIR/load_test" --file "$FILE" --mapped | tail -n +2 | sed "s/^/$ASSESSMENTS\tmapped\t/"
+    "$BIN_DIR/load_test" --file "$FILE" | tail -n +2 | sed "s/^/$ASSESSMENTS\towning\t/"
+done